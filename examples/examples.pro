@@ -3,13 +3,17 @@ TEMPLATE = subdirs
 # c++
 SUBDIRS += \
     desktop \
+    flickbenchmark \
+    layoutbenchmark \
     layouts \
     listbox \
     messagebox \
     mycontrols \
+    skinbenchmark \
     sliders \
     thumbnails \
-    tabview
+    tabview \
+    textbenchmark
 
 qtHaveModule(svg) {
 
@@ -0,0 +1,306 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include <QskAnimator.h>
+#include <QskScrollArea.h>
+#include <QskWindow.h>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QGuiApplication>
+#include <QMouseEvent>
+#include <QTextStream>
+#include <QTimer>
+#include <QVector>
+
+#include <cmath>
+
+/*
+    Replaying touch traces on a scroll area: the events are sent with the
+    timestamps of the trace, so that the velocity of the flick at the end
+    of each trace is the same for all runs. The animators are running
+    with the virtual clock, so the flick is advanced by the same steps,
+    whatever the frame rate is.
+
+    Traces can be loaded from files with one event per line:
+
+        <timestamp in ms> <x> <y>
+
+    The first event is the press, the last one the release. Without
+    traces from files a couple of synthetic traces are replayed.
+ */
+
+namespace
+{
+    class Sample
+    {
+      public:
+        ulong timestamp;
+        QPointF pos;
+    };
+
+    class Trace
+    {
+      public:
+        QString name;
+        QVector< Sample > samples;
+    };
+}
+
+static Trace loadTrace( const QString& fileName )
+{
+    Trace trace;
+    trace.name = fileName;
+
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        qWarning() << "Can't open" << fileName;
+        return trace;
+    }
+
+    QTextStream stream( &file );
+    while ( !stream.atEnd() )
+    {
+        const auto line = stream.readLine().trimmed();
+        if ( line.isEmpty() || line.startsWith( '#' ) )
+            continue;
+
+        const auto values = line.split( ' ', QString::SkipEmptyParts );
+        if ( values.size() == 3 )
+        {
+            const Sample sample { values[ 0 ].toULong(),
+                QPointF( values[ 1 ].toDouble(), values[ 2 ].toDouble() ) };
+
+            trace.samples += sample;
+        }
+    }
+
+    return trace;
+}
+
+static Trace swipeTrace( const char* name, int count,
+    qreal step, const int intervals[ 2 ], int pause )
+{
+    Trace trace;
+    trace.name = name;
+
+    ulong timestamp = 0;
+    QPointF pos( 0.0, 0.0 );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        trace.samples += Sample { timestamp, pos };
+
+        timestamp += intervals[ i % 2 ];
+        pos.ry() -= step;
+    }
+
+    // release
+    trace.samples += Sample { timestamp + pause, pos };
+
+    return trace;
+}
+
+static QVector< Trace > syntheticTraces()
+{
+    QVector< Trace > traces;
+
+    const int regular[] = { 8, 8 };
+    const int bursts[] = { 1, 15 }; // irregular delivery of the events
+
+    traces += swipeTrace( "steady", 25, 12.0, regular, 8 );
+    traces += swipeTrace( "bursts", 25, 12.0, bursts, 8 );
+    traces += swipeTrace( "pause", 25, 12.0, regular, 200 );
+
+    Trace reversal;
+    reversal.name = "reversal";
+
+    ulong timestamp = 0;
+    QPointF pos( 0.0, 0.0 );
+
+    for ( int i = 0; i < 25; i++ )
+    {
+        reversal.samples += Sample { timestamp, pos };
+
+        timestamp += 8;
+        pos.ry() += ( i < 15 ) ? 10.0 : -12.0;
+    }
+
+    reversal.samples += Sample { timestamp, pos };
+    traces += reversal;
+
+    return traces;
+}
+
+static void sendMouseEvent( QQuickWindow* window,
+    QEvent::Type type, const QPointF& pos, ulong timestamp )
+{
+    const auto button = ( type == QEvent::MouseMove )
+        ? Qt::NoButton : Qt::LeftButton;
+
+    const auto buttons = ( type == QEvent::MouseButtonRelease )
+        ? Qt::NoButton : Qt::LeftButton;
+
+    QMouseEvent event( type, pos, pos, window->mapToGlobal( pos.toPoint() ),
+        button, buttons, Qt::NoModifier );
+    event.setTimestamp( timestamp );
+
+    QCoreApplication::sendEvent( window, &event );
+}
+
+static void waitForFrame( QQuickWindow* window )
+{
+    QEventLoop loop;
+
+    QObject::connect( window, &QQuickWindow::frameSwapped,
+        &loop, &QEventLoop::quit, Qt::QueuedConnection );
+
+    // not being exposed
+    QTimer::singleShot( 1000, &loop, &QEventLoop::quit );
+
+    window->update();
+    loop.exec();
+}
+
+static void replay( QQuickWindow* window, QskScrollArea* scrollArea,
+    const Trace& trace, int iterations, ulong& timestamp )
+{
+    if ( trace.samples.size() < 2 )
+        return;
+
+    const QPointF center( 0.5 * window->width(), 0.5 * window->height() );
+
+    qint64 nsEvents = 0;
+    qreal distance = 0.0;
+    int frames = 0;
+
+    QskAnimator::resetFrameStatistics();
+
+    for ( int i = 0; i < iterations; i++ )
+    {
+        const qreal y = 0.5 * scrollArea->scrollableSize().height();
+        scrollArea->setScrollPos( QPointF( 0.0, y ) );
+        waitForFrame( window );
+
+        /*
+            The gesture recognizer ignores events, that are not
+            younger than the ones it has processed before.
+         */
+        timestamp += 1000;
+        const ulong offset = timestamp - trace.samples.first().timestamp;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( int j = 0; j < trace.samples.size(); j++ )
+        {
+            const auto& sample = trace.samples[ j ];
+
+            auto type = QEvent::MouseMove;
+            if ( j == 0 )
+                type = QEvent::MouseButtonPress;
+            else if ( j == trace.samples.size() - 1 )
+                type = QEvent::MouseButtonRelease;
+
+            sendMouseEvent( window, type,
+                center + sample.pos, sample.timestamp + offset );
+        }
+
+        nsEvents += timer.nsecsElapsed();
+        timestamp = trace.samples.last().timestamp + offset;
+
+        // running the flick until the scroll position does not change anymore
+
+        const auto startPos = scrollArea->scrollPos();
+        auto pos = startPos;
+
+        for ( int j = 0; j < 2000; j++ )
+        {
+            waitForFrame( window );
+            frames++;
+
+            if ( scrollArea->scrollPos() == pos )
+                break;
+
+            pos = scrollArea->scrollPos();
+        }
+
+        distance += std::abs( pos.y() - startPos.y() );
+    }
+
+    const auto statistics = QskAnimator::frameStatistics( window );
+
+    const qreal usEvent = nsEvents / ( 1000.0 * iterations * trace.samples.size() );
+
+    qreal usAdvance = 0.0;
+    if ( statistics.frames > 0 )
+        usAdvance = statistics.advanceTime / ( 1000.0 * statistics.frames );
+
+    qDebug().nospace() << trace.name << ": "
+        << "events: " << usEvent << "us, "
+        << "flick: " << distance / iterations << "px, "
+        << "frames: " << qreal( frames ) / iterations << ", "
+        << "advance: " << usAdvance << "us";
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmark for replaying touch traces" );
+    parser.addHelpOption();
+
+    QCommandLineOption traceOption( "trace",
+        "Trace to be replayed, can be given more than once.", "file" );
+    parser.addOption( traceOption );
+
+    QCommandLineOption iterationsOption( "iterations",
+        "Number of times each trace is replayed.", "count", "5" );
+    parser.addOption( iterationsOption );
+
+    QCommandLineOption stepOption( "step",
+        "Step of the virtual clock for each frame in ms.", "ms", "16" );
+    parser.addOption( stepOption );
+
+    parser.process( app );
+
+    const int iterations = qMax( 1, parser.value( iterationsOption ).toInt() );
+
+    QVector< Trace > traces;
+    for ( const auto& fileName : parser.values( traceOption ) )
+        traces += loadTrace( fileName );
+
+    if ( traces.isEmpty() )
+        traces = syntheticTraces();
+
+    QskAnimator::setClockType( QskAnimator::VirtualTime );
+    QskAnimator::setClockStep( qMax( 1, parser.value( stepOption ).toInt() ) );
+    QskAnimator::setFrameStatisticsEnabled( true );
+
+    auto content = new QskControl();
+    content->setFixedSize( 1000, 1000000 );
+
+    auto scrollArea = new QskScrollArea();
+    scrollArea->setScrolledItem( content );
+
+    QskWindow window;
+    window.addItem( scrollArea );
+    window.resize( 600, 800 );
+    window.show();
+
+    waitForFrame( &window );
+
+    ulong timestamp = 0;
+
+    for ( const auto& trace : qAsConst( traces ) )
+        replay( &window, scrollArea, trace, iterations, timestamp );
+
+    return 0;
+}
@@ -0,0 +1,7 @@
+CONFIG += qskexample
+
+# comparing with the solver of QGridLayoutEngine
+QT += gui-private
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,594 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include <QskAnimator.h>
+#include <QskGridBox.h>
+#include <QskLayoutEngine.h>
+#include <QskLinearBox.h>
+#include <QskPushButton.h>
+#include <QskStackBox.h>
+#include <QskStackBoxAnimator.h>
+#include <QskWindow.h>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QGuiApplication>
+#include <QTimer>
+#include <QVector>
+
+#include <cmath>
+
+/*
+    Measuring the solver of the layout engine: the size hints of the
+    items are cached by the layout items, so what is left is the
+    distribution of the space between the rows and columns.
+
+    QskLayoutEngine is still derived from QGridLayoutEngine, that is used
+    for storing the items only. So the same boxes can also be laid out
+    by the solver of QGridLayoutEngine, to compare the results and the
+    performance of both solvers.
+
+    Showing/hiding the cells of a grid compares the static and
+    the dynamic mode of QskGridBox.
+
+    Inserting items into nested boxes, that are shown in a window,
+    compares collecting the invalidations with beginUpdate/endUpdate
+    with invalidating the boxes for each insertion.
+
+    Sliding between the pages of a stack box compares moving the
+    outgoing page with moving a snapshot of it. The animators are
+    running with the virtual clock, so that both modes advance
+    through the same number of frames. With the threaded render loop
+    the items are moved on the scene graph thread, QSG_RENDER_LOOP=basic
+    moves them in the GUI thread.
+ */
+
+namespace
+{
+    // the same as the one of QskLayoutEngine
+    class LayoutStyleInfo final : public QAbstractLayoutStyleInfo
+    {
+      public:
+        qreal spacing( Qt::Orientation ) const override
+        {
+            return 5.0;
+        }
+
+        qreal windowMargin( Qt::Orientation ) const override
+        {
+            return 0;
+        }
+
+        bool hasChangedCore() const override
+        {
+            return false;
+        }
+    };
+}
+
+template< typename Box >
+class BenchmarkBox : public Box
+{
+  public:
+    BenchmarkBox()
+        : m_layoutCount( 0 )
+        , m_layoutTime( 0 )
+    {
+    }
+
+    QSizeF layoutHint( bool qtSolver ) const
+    {
+        if ( qtSolver )
+        {
+            return this->engine().QGridLayoutEngine::sizeHint(
+                Qt::PreferredSize, QSizeF(), &m_styleInfo );
+        }
+
+        return this->layoutItemsSizeHint();
+    }
+
+    void layout( bool qtSolver )
+    {
+        if ( qtSolver )
+        {
+            this->engine().QGridLayoutEngine::setGeometries(
+                this->alignedLayoutRect( this->layoutRect() ), &m_styleInfo );
+        }
+        else
+        {
+            this->updateLayout();
+        }
+    }
+
+    void resetLayoutStatistics()
+    {
+        m_layoutCount = 0;
+        m_layoutTime = 0;
+    }
+
+    int layoutCount() const
+    {
+        return m_layoutCount;
+    }
+
+    qint64 layoutTime() const
+    {
+        return m_layoutTime;
+    }
+
+  protected:
+    void updateLayout() override
+    {
+        // also called from the polish cycle
+        QElapsedTimer timer;
+        timer.start();
+
+        Box::updateLayout();
+
+        m_layoutTime += timer.nsecsElapsed();
+        m_layoutCount++;
+    }
+
+  private:
+    const LayoutStyleInfo m_styleInfo;
+
+    int m_layoutCount;
+    qint64 m_layoutTime;
+};
+
+static qreal qskDeviation( const QRectF& r1, const QRectF& r2 )
+{
+    return qMax( qMax( std::abs( r1.left() - r2.left() ), std::abs( r1.top() - r2.top() ) ),
+        qMax( std::abs( r1.right() - r2.right() ), std::abs( r1.bottom() - r2.bottom() ) ) );
+}
+
+static QskControl* createItem( int index )
+{
+    auto control = new QskControl();
+    control->setPreferredSize( 50 + index % 30, 20 + index % 10 );
+
+    if ( index % 3 == 0 )
+        control->setSizePolicy( QskSizePolicy::Expanding, QskSizePolicy::Preferred );
+    else
+        control->setSizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Fixed );
+
+    return control;
+}
+
+template< typename Box >
+static void compareSolvers( const char* title, BenchmarkBox< Box >* box,
+    const QVector< QskControl* >& controls )
+{
+    const QSizeF hint = box->layoutHint( false );
+    const QSizeF qtHint = box->layoutHint( true );
+
+    qreal deviation = qMax( std::abs( hint.width() - qtHint.width() ),
+        std::abs( hint.height() - qtHint.height() ) );
+
+    QVector< QRectF > geometries( controls.size() );
+
+    // sizes below, at and above the preferred size
+    for ( const qreal f : { 0.3, 0.8, 1.0, 1.5 } )
+    {
+        box->setSize( QSizeF( f * hint.width(), f * hint.height() ) );
+
+        box->layout( false );
+
+        for ( int i = 0; i < controls.size(); i++ )
+            geometries[ i ] = controls[ i ]->geometry();
+
+        box->layout( true );
+
+        for ( int i = 0; i < controls.size(); i++ )
+        {
+            deviation = qMax( deviation,
+                qskDeviation( geometries[ i ], controls[ i ]->geometry() ) );
+        }
+    }
+
+    qDebug().nospace() << title << " " << controls.size() << " items: "
+        << "max. deviation from QGridLayoutEngine: " << deviation;
+}
+
+template< typename Box >
+static void runBenchmark( const char* title,
+    BenchmarkBox< Box >* box, int itemCount, int iterations )
+{
+    const QSizeF hint = box->layoutHint( false );
+
+    // invalidate() should not calculate the implicit size with our solver
+    box->setControlFlag( QskControl::DeferredLayout );
+
+    for ( const bool qtSolver : { false, true } )
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( int i = 0; i < iterations; i++ )
+            ( void ) box->layoutHint( qtSolver );
+
+        const qint64 nsHint = timer.nsecsElapsed() / iterations;
+
+        timer.start();
+
+        for ( int i = 0; i < iterations; i++ )
+        {
+            // alternating sizes below and above the preferred size
+            const qreal f = ( i % 2 ) ? 0.8 : 1.5;
+            box->setSize( QSizeF( f * hint.width(), f * hint.height() ) );
+
+            box->layout( qtSolver );
+        }
+
+        const qint64 nsLayout = timer.nsecsElapsed() / iterations;
+
+        timer.start();
+
+        for ( int i = 0; i < iterations; i++ )
+        {
+            // what happens for each polish cycle after a change
+            box->invalidate();
+
+            ( void ) box->layoutHint( qtSolver );
+            box->layout( qtSolver );
+        }
+
+        const qint64 nsInvalidated = timer.nsecsElapsed() / iterations;
+
+        qDebug().nospace() << title << " " << itemCount << " items, "
+            << ( qtSolver ? "QGridLayoutEngine" : "QskLayoutChain" ) << ": "
+            << "size hint: " << nsHint / 1000.0 << "us, "
+            << "layout: " << nsLayout / 1000.0 << "us, "
+            << "invalidated: " << nsInvalidated / 1000.0 << "us";
+    }
+}
+
+static void benchmarkLinearBox( int itemCount, int iterations )
+{
+    auto box = new BenchmarkBox< QskLinearBox >();
+    box->setOrientation( Qt::Vertical );
+
+    QVector< QskControl* > controls;
+
+    for ( int i = 0; i < itemCount; i++ )
+    {
+        auto control = createItem( i );
+        box->addItem( control );
+
+        if ( i % 10 == 9 )
+            box->addSpacer( 5 );
+
+        if ( i % 20 == 0 )
+            box->setStretchFactor( control, 1 + i % 3 );
+
+        controls += control;
+    }
+
+    compareSolvers( "QskLinearBox", box, controls );
+    runBenchmark( "QskLinearBox", box, itemCount, iterations );
+
+    delete box;
+}
+
+static void benchmarkGridBox( int itemCount, int iterations )
+{
+    const int columnCount = qMax( 1, int( std::sqrt( itemCount ) ) );
+
+    auto box = new BenchmarkBox< QskGridBox >();
+
+    QVector< QskControl* > controls;
+
+    for ( int i = 0; i < itemCount; i++ )
+    {
+        const int row = i / columnCount;
+        const int column = i % columnCount;
+
+        auto control = createItem( i );
+
+        if ( i % 7 == 0 && column < columnCount - 1 )
+        {
+            // some items spanning 2 columns
+            box->addItem( control, row, column, 1, 2 );
+            i++;
+        }
+        else
+        {
+            box->addItem( control, row, column );
+        }
+
+        controls += control;
+    }
+
+    box->setColumnStretchFactor( 0, 2 );
+    box->setRowStretchFactor( 0, 1 );
+
+    compareSolvers( "QskGridBox", box, controls );
+    runBenchmark( "QskGridBox", box, itemCount, iterations );
+
+    delete box;
+}
+
+static void waitForFrame( QQuickWindow* window )
+{
+    QEventLoop loop;
+
+    QObject::connect( window, &QQuickWindow::frameSwapped,
+        &loop, &QEventLoop::quit, Qt::QueuedConnection );
+
+    // not being exposed
+    QTimer::singleShot( 1000, &loop, &QEventLoop::quit );
+
+    window->update();
+    loop.exec();
+}
+
+static void benchmarkNestedInsertion( QskWindow* window, bool batched )
+{
+    const int boxCount = 10;
+    const int itemCount = 500;
+
+    auto outerBox = new QskLinearBox( Qt::Vertical );
+
+    QVector< QskLinearBox* > boxes;
+
+    for ( int i = 0; i < boxCount; i++ )
+    {
+        auto box = new QskLinearBox( Qt::Horizontal );
+        outerBox->addItem( box );
+
+        boxes += box;
+    }
+
+    window->addItem( outerBox );
+    waitForFrame( window );
+
+    int sizeChanges = 0;
+
+    QObject::connect( outerBox, &QQuickItem::implicitWidthChanged,
+        outerBox, [ &sizeChanges ]() { sizeChanges++; } );
+
+    QObject::connect( outerBox, &QQuickItem::implicitHeightChanged,
+        outerBox, [ &sizeChanges ]() { sizeChanges++; } );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if ( batched )
+    {
+        outerBox->beginUpdate();
+
+        for ( auto box : qAsConst( boxes ) )
+            box->beginUpdate();
+    }
+
+    for ( int i = 0; i < itemCount; i++ )
+        boxes[ i % boxCount ]->addItem( createItem( i ) );
+
+    if ( batched )
+    {
+        for ( auto box : qAsConst( boxes ) )
+            box->endUpdate();
+
+        outerBox->endUpdate();
+    }
+
+    const qint64 nsInsert = timer.nsecsElapsed();
+
+    // the deferred propagations are done in the next polish cycle
+    waitForFrame( window );
+
+    const qint64 nsFrame = timer.nsecsElapsed();
+
+    qDebug().nospace() << "QskLinearBox " << boxCount << " nested boxes, "
+        << itemCount << " items, " << ( batched ? "batched" : "not batched" ) << ": "
+        << "inserting: " << nsInsert / 1e6 << "ms, "
+        << "until rendered: " << nsFrame / 1e6 << "ms, "
+        << "implicit size changes of the outer box: " << sizeChanges;
+
+    delete outerBox;
+}
+
+static void benchmarkGridVisibility( QskWindow* window, bool isStatic )
+{
+    const int cellCount = 1000;
+    const int columnCount = 40;
+    const int togglesPerFrame = 10;
+
+    auto box = new BenchmarkBox< QskGridBox >();
+    box->setStaticGrid( isStatic );
+
+    QVector< QskControl* > controls;
+
+    for ( int i = 0; i < cellCount; i++ )
+    {
+        auto control = createItem( i );
+        box->addItem( control, i / columnCount, i % columnCount );
+
+        controls += control;
+    }
+
+    /*
+        The grid is shown, so that the layout requests are postponed
+        to the polish cycle, where the requests of a static grid
+        for showing/hiding its items are dropped.
+     */
+    window->addItem( box );
+    waitForFrame( window );
+
+    box->resetLayoutStatistics();
+
+    qint64 nsToggle = 0;
+    int frames = 0;
+
+    QElapsedTimer timer;
+
+    // hiding and showing each cell, with a frame after every few toggles
+
+    for ( int i = 0; i < 2 * cellCount; i++ )
+    {
+        timer.start();
+
+        auto control = controls[ i % cellCount ];
+        control->setVisible( !control->isVisible() );
+
+        nsToggle += timer.nsecsElapsed();
+
+        if ( ( i + 1 ) % togglesPerFrame == 0 )
+        {
+            waitForFrame( window );
+            frames++;
+        }
+    }
+
+    qreal usLayout = 0.0;
+    if ( box->layoutCount() > 0 )
+        usLayout = box->layoutTime() / ( 1000.0 * box->layoutCount() );
+
+    qDebug().nospace() << "QskGridBox " << cellCount << " cells, "
+        << ( isStatic ? "static" : "dynamic" ) << ": "
+        << "toggling visibility: " << nsToggle / ( 1000.0 * 2 * cellCount ) << "us, "
+        << "layouts: " << box->layoutCount() << " in " << frames << " frames, "
+        << "layout: " << usLayout << "us";
+
+    delete box;
+}
+
+static BenchmarkBox< QskGridBox >* createPage( int buttonCount )
+{
+    const int columnCount = 20;
+
+    auto page = new BenchmarkBox< QskGridBox >();
+
+    for ( int i = 0; i < buttonCount; i++ )
+    {
+        auto button = new QskPushButton( QString::number( i ) );
+        page->addItem( button, i / columnCount, i % columnCount );
+    }
+
+    return page;
+}
+
+static void benchmarkStackTransition( QskWindow* window, bool snapshotMode )
+{
+    const int transitions = 10;
+    const int buttonCount = 400;
+
+    auto stackBox = new QskStackBox();
+
+    auto animator = new QskStackBoxAnimator1( stackBox );
+    animator->setDuration( 500 );
+    animator->setSnapshotMode( snapshotMode );
+
+    stackBox->setAnimator( animator );
+
+    BenchmarkBox< QskGridBox >* pages[ 2 ];
+
+    for ( auto& page : pages )
+    {
+        page = createPage( buttonCount );
+        stackBox->addItem( page );
+    }
+
+    window->addItem( stackBox );
+    waitForFrame( window );
+
+    for ( auto page : pages )
+        page->resetLayoutStatistics();
+
+    QskAnimator::resetFrameStatistics();
+
+    int frames = 0;
+    qint64 nsFrames = 0;
+    qint64 nsMaxFrame = 0;
+
+    for ( int i = 0; i < transitions; i++ )
+    {
+        stackBox->setCurrentIndex( ( i + 1 ) % 2 );
+
+        while ( animator->isRunning() && frames < 1000 * transitions )
+        {
+            QElapsedTimer timer;
+            timer.start();
+
+            waitForFrame( window );
+
+            const qint64 ns = timer.nsecsElapsed();
+
+            nsFrames += ns;
+            nsMaxFrame = qMax( nsMaxFrame, ns );
+            frames++;
+        }
+    }
+
+    const auto statistics = QskAnimator::frameStatistics( window );
+
+    int layoutCount = 0;
+    for ( auto page : pages )
+        layoutCount += page->layoutCount();
+
+    qreal usFrame = 0.0;
+    qreal updates = 0.0;
+
+    if ( frames > 0 )
+        usFrame = nsFrames / ( 1000.0 * frames );
+
+    if ( statistics.frames > 0 )
+        updates = qreal( statistics.updates ) / statistics.frames;
+
+    qDebug().nospace() << "QskStackBox " << buttonCount << " buttons per page, "
+        << ( snapshotMode ? "snapshot" : "live" ) << ": "
+        << "frames: " << frames << ", "
+        << "frame: " << usFrame << "us, "
+        << "max. frame: " << nsMaxFrame / 1000.0 << "us, "
+        << "updates: " << updates << " per frame, "
+        << "layouts: " << layoutCount;
+
+    delete stackBox;
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmark for the layout engine" );
+    parser.addHelpOption();
+
+    QCommandLineOption iterationsOption( "iterations",
+        "Number of layout passes for each measurement.", "count", "100" );
+    parser.addOption( iterationsOption );
+
+    parser.process( app );
+
+    const int iterations = qMax( 1, parser.value( iterationsOption ).toInt() );
+
+    for ( const int itemCount : { 10, 100, 1000 } )
+    {
+        benchmarkLinearBox( itemCount, iterations );
+        benchmarkGridBox( itemCount, iterations );
+    }
+
+    QskWindow window;
+    window.resize( 800, 600 );
+    window.show();
+
+    waitForFrame( &window );
+
+    benchmarkNestedInsertion( &window, false );
+    benchmarkNestedInsertion( &window, true );
+
+    benchmarkGridVisibility( &window, false );
+    benchmarkGridVisibility( &window, true );
+
+    QskAnimator::setClockType( QskAnimator::VirtualTime );
+    QskAnimator::setFrameStatisticsEnabled( true );
+
+    benchmarkStackTransition( &window, false );
+    benchmarkStackTransition( &window, true );
+
+    return 0;
+}
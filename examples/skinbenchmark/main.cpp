@@ -0,0 +1,176 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include <QskGridBox.h>
+#include <QskPushButton.h>
+#include <QskWindow.h>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QVector>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+/*
+    Measuring the costs of a state change of a control: QskSkinnable::setSkinState
+    has to find out, which hints differ between the old and the new state
+    and starts the transitions for them.
+
+    Without showing the window the buttons are not painted and no
+    transitions are started, so what is left is detecting the
+    differences between the states.
+
+    The allocations of the GUI thread, that are done by operator new, are
+    counted while changing the states. Qt containers allocate with malloc
+    and are not included. On platforms, where the libraries do not use
+    the operator new of the application ( f.e. Windows ), only the
+    allocations of the benchmark itself are counted.
+ */
+
+static std::atomic< bool > qskIsCounting( false );
+static std::thread::id qskCountingThread;
+static qint64 qskAllocations = 0; // only written from qskCountingThread
+
+void* operator new( std::size_t size )
+{
+    if ( qskIsCounting.load( std::memory_order_relaxed )
+        && std::this_thread::get_id() == qskCountingThread )
+    {
+        qskAllocations++;
+    }
+
+    if ( auto ptr = std::malloc( size > 0 ? size : 1 ) )
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void* ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete( void* ptr, std::size_t ) noexcept
+{
+    std::free( ptr );
+}
+
+static void startCounting()
+{
+    qskCountingThread = std::this_thread::get_id();
+    qskAllocations = 0;
+
+    qskIsCounting = true;
+}
+
+static qint64 stopCounting()
+{
+    qskIsCounting = false;
+    return qskAllocations;
+}
+
+class Button : public QskPushButton
+{
+  public:
+    Button( int index )
+    {
+        setText( QString::number( index ) );
+    }
+
+    void setHovered( bool on )
+    {
+        setSkinStateFlag( QskControl::Hovered, on );
+    }
+};
+
+static void waitForPainted( const Button* button )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while ( !button->isInitiallyPainted() && timer.elapsed() < 5000 )
+        QCoreApplication::processEvents( QEventLoop::AllEvents, 50 );
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmark for changing the skin state" );
+    parser.addHelpOption();
+
+    QCommandLineOption countOption( "buttons",
+        "Number of buttons.", "count", "1000" );
+    parser.addOption( countOption );
+
+    QCommandLineOption iterationsOption( "iterations",
+        "Number of times each button is hovered and left again.", "count", "10" );
+    parser.addOption( iterationsOption );
+
+    QCommandLineOption showOption( "show",
+        "Showing the window, so that the transitions are started." );
+    parser.addOption( showOption );
+
+    parser.process( app );
+
+    const int buttonCount = qMax( 1, parser.value( countOption ).toInt() );
+    const int iterations = qMax( 1, parser.value( iterationsOption ).toInt() );
+
+    QskWindow window;
+    window.resize( 1200, 800 );
+
+    auto box = new QskGridBox();
+
+    QVector< Button* > buttons;
+    buttons.reserve( buttonCount );
+
+    for ( int i = 0; i < buttonCount; i++ )
+    {
+        auto button = new Button( i );
+        box->addItem( button, i / 40, i % 40 );
+
+        buttons += button;
+    }
+
+    window.addItem( box );
+
+    if ( parser.isSet( showOption ) )
+    {
+        window.show();
+        waitForPainted( buttons.last() );
+    }
+
+    const int stateChanges = 2 * iterations * buttonCount;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    startCounting();
+
+    for ( int i = 0; i < iterations; i++ )
+    {
+        for ( auto button : qAsConst( buttons ) )
+        {
+            button->setHovered( true );
+            button->setHovered( false );
+        }
+    }
+
+    const qint64 allocations = stopCounting();
+    const qint64 nsToggle = timer.nsecsElapsed() / stateChanges;
+
+    qDebug().nospace() << "QskPushButton " << buttonCount << " buttons, "
+        << ( buttons.last()->isInitiallyPainted() ? "painted" : "not painted" ) << ": "
+        << "toggling Hovered: " << nsToggle / 1000.0 << "us, "
+        << "allocations: " << qreal( allocations ) / stateChanges << " per state change";
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include <QskPlainTextRenderer.h>
+#include <QskSimpleListBox.h>
+#include <QskTextOptions.h>
+#include <QskWindow.h>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFontMetricsF>
+#include <QGuiApplication>
+#include <QStringList>
+#include <QTimer>
+
+/*
+    Measuring the elision of the texts of a list with a million rows:
+    the visible rows are elided for each frame, while scrolling
+    back and forth ( the texts of the previous frames come again )
+    or jumping through the list ( no text comes again ).
+
+    The results are compared with eliding the texts without the cache
+    of QskPlainTextRenderer, that also has to return the same texts.
+
+    With --show the same texts are displayed by a QskSimpleListBox,
+    that is scrolled, while measuring the time between the frames.
+ */
+
+static QStringList createEntries( int count )
+{
+    static const char* words[] =
+    {
+        "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel"
+    };
+
+    QStringList entries;
+    entries.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        auto entry = QStringLiteral( "Row %1:" ).arg( i );
+
+        for ( int j = 0; j < 3 + i % 5; j++ )
+        {
+            entry += ' ';
+            entry += words[ ( i + j ) % 8 ];
+        }
+
+        entries += entry;
+    }
+
+    return entries;
+}
+
+static inline QString elidedText( bool cached, const QString& text,
+    const QFont& font, const QFontMetricsF& fm, qreal width )
+{
+    if ( cached )
+        return QskPlainTextRenderer::elidedText( text, font, Qt::ElideRight, width );
+
+    return fm.elidedText( text, Qt::ElideRight, width, Qt::TextShowMnemonic );
+}
+
+static void benchmarkElision( const QStringList& entries,
+    bool jumping, int visibleRows, int frames )
+{
+    const QFont font;
+    const QFontMetricsF fm( font );
+    const qreal width = 150.0;
+
+    qint64 ns[ 2 ] = { 0, 0 };
+    int mismatches = 0;
+
+    for ( const bool cached : { false, true } )
+    {
+        int row = 0;
+        int step = 3;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( int i = 0; i < frames; i++ )
+        {
+            if ( jumping )
+            {
+                row = ( row + 7919 * visibleRows ) % ( entries.count() - visibleRows );
+            }
+            else
+            {
+                // flicking 300 rows down and up again
+
+                if ( ( i % 100 ) == 0 && i > 0 )
+                    step = -step;
+
+                row += step;
+            }
+
+            for ( int j = row; j < row + visibleRows; j++ )
+                ( void ) elidedText( cached, entries[ j ], font, fm, width );
+        }
+
+        ns[ cached ] = timer.nsecsElapsed() / frames;
+    }
+
+    // the cached texts have to be the same
+
+    for ( int i = 0; i < entries.count(); i += 997 )
+    {
+        if ( elidedText( true, entries[ i ], font, fm, width )
+            != elidedText( false, entries[ i ], font, fm, width ) )
+        {
+            mismatches++;
+        }
+    }
+
+    qDebug().nospace() << entries.count() << " rows, "
+        << ( jumping ? "jumping" : "scrolling" ) << ": "
+        << "uncached: " << ns[ 0 ] / 1000.0 << "us, "
+        << "cached: " << ns[ 1 ] / 1000.0 << "us per frame, "
+        << "mismatches: " << mismatches;
+}
+
+static void waitForFrame( QQuickWindow* window )
+{
+    QEventLoop loop;
+
+    QObject::connect( window, &QQuickWindow::frameSwapped,
+        &loop, &QEventLoop::quit, Qt::QueuedConnection );
+
+    // not being exposed
+    QTimer::singleShot( 1000, &loop, &QEventLoop::quit );
+
+    window->update();
+    loop.exec();
+}
+
+static void benchmarkListBox( const QStringList& entries, int frames )
+{
+    QskTextOptions textOptions;
+    textOptions.setElideMode( Qt::ElideRight );
+
+    auto listBox = new QskSimpleListBox();
+    listBox->setTextOptions( textOptions );
+
+    // a hint, that is too small for the texts, and avoids measuring them
+    listBox->setColumnWidthHint( 0, 150 );
+    listBox->setEntries( entries );
+
+    QskWindow window;
+    window.addItem( listBox );
+    window.resize( 400, 800 );
+    window.show();
+
+    waitForFrame( &window );
+
+    const qreal rowHeight = listBox->rowHeight();
+    qreal y = 0.0;
+    qreal step = 3 * rowHeight;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for ( int i = 0; i < frames; i++ )
+    {
+        if ( ( i % 100 ) == 0 && i > 0 )
+            step = -step;
+
+        y += step;
+
+        listBox->setScrollPos( QPointF( 0.0, y ) );
+        waitForFrame( &window );
+    }
+
+    const qint64 nsFrame = timer.nsecsElapsed() / frames;
+
+    qDebug().nospace() << "QskSimpleListBox " << entries.count() << " rows: "
+        << "scrolling: " << nsFrame / 1000.0 << "us per frame";
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmark for eliding the texts of a list" );
+    parser.addHelpOption();
+
+    QCommandLineOption rowsOption( "rows",
+        "Number of rows.", "count", "1000000" );
+    parser.addOption( rowsOption );
+
+    QCommandLineOption framesOption( "frames",
+        "Number of frames for each measurement.", "count", "1000" );
+    parser.addOption( framesOption );
+
+    QCommandLineOption showOption( "show",
+        "Scrolling a QskSimpleListBox with the same rows." );
+    parser.addOption( showOption );
+
+    parser.process( app );
+
+    const int rowCount = qMax( 1000, parser.value( rowsOption ).toInt() );
+    const int frames = qMax( 1, parser.value( framesOption ).toInt() );
+
+    const auto entries = createEntries( rowCount );
+
+    benchmarkElision( entries, false, 40, frames );
+    benchmarkElision( entries, true, 40, frames );
+
+    if ( parser.isSet( showOption ) )
+        benchmarkListBox( entries, frames );
+
+    return 0;
+}
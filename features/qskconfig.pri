@@ -45,6 +45,9 @@ RCC_DIR      = rcc
 
 QSK_CONFIG += QskDll
 
+# Recording polish/layout/size hint calculations: see QskLayoutProfiler
+# QSK_CONFIG += QskLayoutProfiler
+
 *-g++* {
 
     GCC_VERSION = $$system("$$QMAKE_CXX -dumpversion")
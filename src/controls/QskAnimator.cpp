@@ -7,24 +7,82 @@
 
 #include <qelapsedtimer.h>
 #include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
 #include <qobject.h>
 #include <qquickwindow.h>
+#include <qscreen.h>
 #include <qvector.h>
 
+QSK_QT_PRIVATE_BEGIN
+#include <private/qquickitem_p.h>
+#include <private/qquickwindow_p.h>
+QSK_QT_PRIVATE_END
+
 #ifndef QT_NO_DEBUG_STREAM
 #include <qdebug.h>
 #endif
 
+static inline bool qskHasEnvironment( const char* env )
+{
+    bool ok;
+
+    const int value = qEnvironmentVariableIntValue( env, &ok );
+    if ( ok )
+        return value != 0;
+
+    // All other strings are true, apart from "false"
+    auto result = qgetenv( env );
+    return !result.isEmpty() && result != "false";
+}
+
 namespace
 {
+    class WindowStatistics
+    {
+      public:
+        WindowStatistics()
+            : lastSwapTime( -1 )
+            , frameInterval( 0 )
+        {
+        }
+
+        QskAnimator::FrameStatistics frames;
+
+        // accessed from the scene graph thread
+        qint64 lastSwapTime;
+        qint64 frameInterval;
+    };
+
     class Statistics
     {
       public:
         inline Statistics()
+            : m_frameStatistics( qskHasEnvironment( "QSK_ANIMATOR_STATISTICS" ) )
         {
+            m_clock.start();
             reset();
         }
 
+        void setFrameStatisticsEnabled( bool on )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( on != m_frameStatistics )
+            {
+                m_frameStatistics = on;
+
+                // restarting the detection of dropped frames
+                for ( auto& statistics : m_windows )
+                    statistics.lastSwapTime = -1;
+            }
+        }
+
+        inline bool isFrameStatisticsEnabled() const
+        {
+            return m_frameStatistics;
+        }
+
 #ifndef QT_NO_DEBUG_STREAM
         void debugStatistics( QDebug debug )
         {
@@ -35,6 +93,25 @@ namespace
                   << ", destroyed: " << destroyed
                   << ", current: " << current
                   << ", maximum: " << maximum;
+
+            QMutexLocker locker( &m_mutex );
+
+            for ( auto it = m_windows.constBegin(); it != m_windows.constEnd(); ++it )
+            {
+                const auto& frames = it.value().frames;
+
+                debug << ", " << it.key() << ": ("
+                      << "frames: " << frames.frames
+                      << ", dropped: " << frames.droppedFrames
+                      << ", animators: " << frames.animators
+                      << ", max animators: " << frames.maxAnimators
+                      << ", advance[ms]: " << frames.advanceTime / 1e6
+                      << ", max advance[ms]: " << frames.maxAdvanceTime / 1e6
+                      << ", polishes: " << frames.polishes
+                      << ", updates: " << frames.updates
+                      << ')';
+            }
+
             debug << ')';
         }
 #endif
@@ -44,6 +121,14 @@ namespace
             created = destroyed = current = maximum = 0;
         }
 
+        void resetFrames()
+        {
+            QMutexLocker locker( &m_mutex );
+
+            for ( auto& statistics : m_windows )
+                statistics.frames = QskAnimator::FrameStatistics();
+        }
+
         inline void increment()
         {
             created++;
@@ -59,10 +144,172 @@ namespace
             current--;
         }
 
+        inline qint64 timestamp() const
+        {
+            return m_clock.nsecsElapsed();
+        }
+
+        void watchWindow( const QQuickWindow* window, qreal refreshRate )
+        {
+            if ( refreshRate <= 0.0 )
+                refreshRate = 60.0;
+
+            QMutexLocker locker( &m_mutex );
+
+            auto& statistics = m_windows[ window ];
+            statistics.lastSwapTime = -1;
+            statistics.frameInterval = qint64( 1e9 / refreshRate );
+        }
+
+        void removeWindow( const QQuickWindow* window )
+        {
+            QMutexLocker locker( &m_mutex );
+            m_windows.remove( window );
+        }
+
+        void advance( const QQuickWindow* window, int animators,
+            qint64 duration, int polishes, int updates )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            auto& frames = m_windows[ window ].frames;
+
+            frames.frames++;
+
+            frames.animators = animators;
+            frames.maxAnimators = qMax( frames.maxAnimators, animators );
+
+            frames.lastAdvanceTime = duration;
+            frames.advanceTime += duration;
+            frames.maxAdvanceTime = qMax( frames.maxAdvanceTime, duration );
+
+            frames.polishes += polishes;
+            frames.updates += updates;
+        }
+
+        void swapFrame( const QQuickWindow* window )
+        {
+            // called from the scene graph thread
+
+            const auto now = timestamp();
+
+            QMutexLocker locker( &m_mutex );
+
+            if ( !m_frameStatistics )
+                return;
+
+            auto it = m_windows.find( window );
+            if ( it == m_windows.end() )
+                return;
+
+            auto& statistics = it.value();
+
+            if ( statistics.lastSwapTime >= 0 && statistics.frameInterval > 0 )
+            {
+                const auto frames = qRound( double( now - statistics.lastSwapTime )
+                    / statistics.frameInterval );
+
+                if ( frames > 1 )
+                    statistics.frames.droppedFrames += frames - 1;
+            }
+
+            statistics.lastSwapTime = now;
+        }
+
+        QskAnimator::FrameStatistics frameStatistics( const QQuickWindow* window ) const
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( window )
+                return m_windows.value( window ).frames;
+
+            // summed up for all windows
+
+            QskAnimator::FrameStatistics frames;
+
+            for ( const auto& statistics : m_windows )
+            {
+                const auto& f = statistics.frames;
+
+                frames.frames += f.frames;
+                frames.droppedFrames += f.droppedFrames;
+                frames.animators += f.animators;
+                frames.maxAnimators = qMax( frames.maxAnimators, f.maxAnimators );
+                frames.advanceTime += f.advanceTime;
+                frames.lastAdvanceTime = qMax( frames.lastAdvanceTime, f.lastAdvanceTime );
+                frames.maxAdvanceTime = qMax( frames.maxAdvanceTime, f.maxAdvanceTime );
+                frames.polishes += f.polishes;
+                frames.updates += f.updates;
+            }
+
+            return frames;
+        }
+
         int created;
         int destroyed;
         int current;
         int maximum;
+
+      private:
+        QElapsedTimer m_clock;
+
+        mutable QMutex m_mutex;
+        QHash< const QQuickWindow*, WindowStatistics > m_windows;
+
+        bool m_frameStatistics;
+    };
+}
+
+Q_GLOBAL_STATIC( Statistics, qskStatistics )
+
+static inline int qskDirtyItemCount( QQuickWindow* window )
+{
+    int count = 0;
+
+    auto item = QQuickWindowPrivate::get( window )->dirtyItemList;
+    while ( item )
+    {
+        count++;
+        item = QQuickItemPrivate::get( item )->nextDirtyItem;
+    }
+
+    return count;
+}
+
+static inline int qskPolishItemCount( QQuickWindow* window )
+{
+    return QQuickWindowPrivate::get( window )->itemsToPolish.size();
+}
+
+namespace
+{
+    /*
+        The running animators of a window. Animators are appended
+        and removed by moving the last one into the gap, so that the
+        index of an animator is its handle for removing it again.
+
+        While advancing, removed animators are only replaced by nullptr
+        and the array is compacted afterwards.
+     */
+    class WindowAnimators
+    {
+      public:
+        WindowAnimators( QQuickWindow* window )
+            : window( window )
+            , clockTime( -1 )
+            , isAdvancing( false )
+            , hasGaps( false )
+        {
+        }
+
+        QQuickWindow* window;
+        QVector< QskAnimator* > animators;
+
+        // the time of the virtual clock, when having advanced the last frame
+        qint64 clockTime;
+
+        bool isAdvancing : 1;
+        bool hasGaps : 1;
     };
 }
 
@@ -77,168 +324,413 @@ class QskAnimatorDriver final : public QObject
 
   public:
     QskAnimatorDriver();
+    ~QskAnimatorDriver() override;
 
     void registerAnimator( QskAnimator* );
     void unregisterAnimator( QskAnimator* );
 
     qint64 referenceTime() const;
 
+    void setClockType( QskAnimator::ClockType );
+    QskAnimator::ClockType clockType() const;
+
+    void setClockStep( int ms );
+    int clockStep() const;
+
+    void advanceClock( int ms );
+
   Q_SIGNALS:
     void advanced( QQuickWindow* );
     void terminated( QQuickWindow* );
 
   private:
+    WindowAnimators* windowAnimators( const QQuickWindow* ) const;
+
     void advanceAnimators( QQuickWindow* );
     void removeWindow( QQuickWindow* );
     void scheduleUpdate( QQuickWindow* );
 
+    void compact( WindowAnimators* );
+
     QElapsedTimer m_referenceTime;
+    qint64 m_timeOffset; // continuing, where the virtual clock had stopped
+
+    qint64 m_virtualTime;
+    int m_clockStep;
 
-    // a sorted vector, good for iterating and good enough for look ups
-    QVector< QskAnimator* > m_animators;
+    QskAnimator::ClockType m_clockType;
 
     /*
        Having a more than a very few windows with running animators is
        very unlikely and using a hash table instead of a vector probably
        creates more overhead than being good for something.
      */
-    QVector< QQuickWindow* > m_windows;
-    mutable int m_index; // current value, when iterating
+    QVector< WindowAnimators* > m_windows;
 };
 
 QskAnimatorDriver::QskAnimatorDriver()
-    : m_index( -1 )
+    : m_timeOffset( 0 )
+    , m_virtualTime( 0 )
+    , m_clockStep( 16 )
+    , m_clockType( QskAnimator::RealTime )
 {
     m_referenceTime.start();
 }
 
-inline qint64 QskAnimatorDriver::referenceTime() const
+QskAnimatorDriver::~QskAnimatorDriver()
 {
-    return m_referenceTime.elapsed();
+    qDeleteAll( m_windows );
 }
 
-void QskAnimatorDriver::registerAnimator( QskAnimator* animator )
+inline qint64 QskAnimatorDriver::referenceTime() const
 {
-    Q_ASSERT( animator->window() );
+    if ( m_clockType == QskAnimator::VirtualTime )
+        return m_virtualTime;
 
-    // do we want to be thread safe ???
+    return m_referenceTime.elapsed() + m_timeOffset;
+}
 
-    auto it = std::lower_bound( m_animators.begin(), m_animators.end(), animator );
-    if ( it != m_animators.end() && *it == animator )
+void QskAnimatorDriver::setClockType( QskAnimator::ClockType type )
+{
+    if ( type == m_clockType )
         return;
 
-    if ( m_index > 0 )
+    /*
+        The start times of the running animators are from the previous
+        clock, so the new one has to continue from the current time.
+     */
+    const auto time = referenceTime();
+
+    if ( type == QskAnimator::VirtualTime )
+        m_virtualTime = time;
+    else
+        m_timeOffset = time - m_referenceTime.elapsed();
+
+    m_clockType = type;
+}
+
+inline QskAnimator::ClockType QskAnimatorDriver::clockType() const
+{
+    return m_clockType;
+}
+
+void QskAnimatorDriver::setClockStep( int ms )
+{
+    m_clockStep = qMax( ms, 0 );
+}
+
+inline int QskAnimatorDriver::clockStep() const
+{
+    return m_clockStep;
+}
+
+void QskAnimatorDriver::advanceClock( int ms )
+{
+    if ( m_clockType == QskAnimator::VirtualTime && ms > 0 )
     {
-        if ( it - m_animators.begin() < m_index )
-            m_index++;
+        m_virtualTime += ms;
+
+        for ( auto windowAnimators : qAsConst( m_windows ) )
+            windowAnimators->window->update();
     }
+}
 
-    m_animators.insert( it, animator );
+inline WindowAnimators* QskAnimatorDriver::windowAnimators(
+    const QQuickWindow* window ) const
+{
+    for ( auto windowAnimators : m_windows )
+    {
+        if ( windowAnimators->window == window )
+            return windowAnimators;
+    }
+
+    return nullptr;
+}
+
+void QskAnimatorDriver::registerAnimator( QskAnimator* animator )
+{
+    Q_ASSERT( animator->window() );
+
+    // do we want to be thread safe ???
+
+    if ( animator->m_driverIndex >= 0 )
+        return;
 
     QQuickWindow* window = animator->window();
-    if ( window )
+    if ( window == nullptr )
+        return;
+
+    auto windowAnimators = this->windowAnimators( window );
+    if ( windowAnimators == nullptr )
     {
-        if ( !m_windows.contains( window ) )
-        {
-            m_windows += window;
+        windowAnimators = new WindowAnimators( window );
+        m_windows += windowAnimators;
 
-            connect( window, &QQuickWindow::afterAnimating,
-                this, [ this, window ]() { advanceAnimators( window ); } );
+        connect( window, &QQuickWindow::afterAnimating,
+            this, [ this, window ]() { advanceAnimators( window ); } );
 
-            connect( window, &QQuickWindow::frameSwapped,
-                this, [ this, window ]() { scheduleUpdate( window ); } );
+        connect( window, &QQuickWindow::frameSwapped,
+            this, [ this, window ]() { scheduleUpdate( window ); } );
 
-            connect( window, &QObject::destroyed,
-                this, [ this, window ]( QObject* ) { removeWindow( window ); } );
+        if ( qskStatistics )
+        {
+            const auto screen = window->screen();
+            qskStatistics->watchWindow( window, screen ? screen->refreshRate() : 0.0 );
 
-            window->update();
+            connect( window, &QQuickWindow::frameSwapped, this,
+                [ window ]() { if ( qskStatistics ) qskStatistics->swapFrame( window ); },
+                Qt::DirectConnection );
         }
+
+        connect( window, &QObject::destroyed,
+            this, [ this, window ]( QObject* ) { removeWindow( window ); } );
+
+        window->update();
     }
+
+    /*
+        When being registered while advancing, the animator
+        will be advanced the first time in the following frame
+     */
+    animator->m_driverIndex = windowAnimators->animators.size();
+    windowAnimators->animators += animator;
 }
 
 void QskAnimatorDriver::scheduleUpdate( QQuickWindow* window )
 {
-    if ( m_windows.contains( window ) )
+    if ( windowAnimators( window ) )
         window->update();
 }
 
 void QskAnimatorDriver::removeWindow( QQuickWindow* window )
 {
     window->disconnect( this );
-    m_windows.removeOne( window );
 
-    for ( auto it = m_animators.begin(); it != m_animators.end(); )
+    if ( qskStatistics )
+        qskStatistics->removeWindow( window );
+
+    auto windowAnimators = this->windowAnimators( window );
+    if ( windowAnimators == nullptr )
+        return;
+
+    m_windows.removeOne( windowAnimators );
+
+    auto& animators = windowAnimators->animators;
+    for ( auto& animator : animators )
+    {
+        if ( animator )
+        {
+            animator->m_driverIndex = -1;
+            animator = nullptr;
+        }
+    }
+
+    if ( windowAnimators->isAdvancing )
+    {
+        // deleted, when advanceAnimators is done
+        windowAnimators->window = nullptr;
+    }
+    else
     {
-        if ( ( *it )->window() == window )
-            it = m_animators.erase( it );
-        else
-            ++it;
+        delete windowAnimators;
     }
 }
 
 void QskAnimatorDriver::unregisterAnimator( QskAnimator* animator )
 {
-    auto it = std::find( m_animators.begin(), m_animators.end(), animator );
-    if ( it != m_animators.end() )
+    const int index = animator->m_driverIndex;
+    if ( index < 0 )
+        return;
+
+    animator->m_driverIndex = -1;
+
+    auto windowAnimators = this->windowAnimators( animator->window() );
+    if ( windowAnimators == nullptr )
+        return;
+
+    auto& animators = windowAnimators->animators;
+    Q_ASSERT( animators[ index ] == animator );
+
+    if ( windowAnimators->isAdvancing )
+    {
+        /*
+            Moving the last animator into the gap would
+            disturb the iteration in advanceAnimators
+         */
+        animators[ index ] = nullptr;
+        windowAnimators->hasGaps = true;
+    }
+    else
     {
-        if ( it - m_animators.begin() < m_index )
-            m_index--;
+        auto last = animators.takeLast();
+        if ( index < animators.size() )
+        {
+            animators[ index ] = last;
+            last->m_driverIndex = index;
+        }
+    }
+}
 
-        m_animators.erase( it );
+void QskAnimatorDriver::compact( WindowAnimators* windowAnimators )
+{
+    auto& animators = windowAnimators->animators;
+
+    int count = 0;
+    for ( int i = 0; i < animators.size(); i++ )
+    {
+        if ( auto animator = animators[ i ] )
+        {
+            animator->m_driverIndex = count;
+            animators[ count++ ] = animator;
+        }
     }
+
+    animators.resize( count );
+    windowAnimators->hasGaps = false;
 }
 
 void QskAnimatorDriver::advanceAnimators( QQuickWindow* window )
 {
-    bool hasAnimators = false;
+    auto windowAnimators = this->windowAnimators( window );
+    if ( windowAnimators == nullptr )
+    {
+        window->disconnect( this );
+        return;
+    }
+
+    if ( m_clockType == QskAnimator::VirtualTime )
+    {
+        /*
+            Windows might be rendered with different frame rates, but the
+            clock must not advance more than once per frame. So it advances,
+            when a window starts another frame for the current time: with
+            one window for each of its frames, with several windows driven
+            by whichever of them is rendering.
+         */
+        if ( windowAnimators->clockTime >= m_virtualTime )
+            m_virtualTime += m_clockStep;
+
+        windowAnimators->clockTime = m_virtualTime;
+    }
+
     bool hasTerminations = false;
 
-    for ( m_index = m_animators.size() - 1; m_index >= 0; m_index-- )
+    auto statistics = qskStatistics();
+    if ( statistics && !statistics->isFrameStatisticsEnabled() )
+        statistics = nullptr;
+
+    qint64 startTime = 0;
+    int polishCount = 0;
+    int dirtyCount = 0;
+
+    if ( statistics )
     {
-        // Advancing animators might create/remove animators, what is handled by
-        // adjusting m_index in register/unregister
+        startTime = statistics->timestamp();
+        polishCount = qskPolishItemCount( window );
+        dirtyCount = qskDirtyItemCount( window );
+    }
 
-        auto animator = m_animators[ m_index ];
-        if ( animator->window() == window )
-        {
-            hasAnimators = true;
+    windowAnimators->isAdvancing = true;
 
-            if ( animator->isRunning() )
-            {
-                animator->update();
+    const auto& animators = windowAnimators->animators;
+    const int animatorCount = animators.size();
 
-                if ( !animator->isRunning() )
-                    hasTerminations = true;
-            }
+    for ( int i = animators.size() - 1; i >= 0; i-- )
+    {
+        /*
+            Advancing animators might create/remove animators. Removed
+            ones leave a nullptr behind, new ones are appended.
+         */
+
+        auto animator = animators[ i ];
+        if ( animator && animator->isRunning() )
+        {
+            animator->update();
+
+            if ( !animator->isRunning() )
+                hasTerminations = true;
         }
     }
 
-    m_index = -1;
+    windowAnimators->isAdvancing = false;
 
-    if ( !hasAnimators )
+    if ( windowAnimators->window == nullptr )
+    {
+        // the window has been destroyed meanwhile
+        delete windowAnimators;
+        return;
+    }
+
+    if ( windowAnimators->hasGaps )
+        compact( windowAnimators );
+
+    if ( windowAnimators->animators.isEmpty() )
     {
         window->disconnect( this );
-        m_windows.removeOne( const_cast< QQuickWindow* >( window ) );
+
+        m_windows.removeOne( windowAnimators );
+        delete windowAnimators;
     }
 
     Q_EMIT advanced( window );
 
     if ( hasTerminations )
         Q_EMIT terminated( window );
+
+    if ( statistics )
+    {
+        // including what has been done by the advance/cleanup handlers
+
+        statistics->advance( window, animatorCount,
+            statistics->timestamp() - startTime,
+            qskPolishItemCount( window ) - polishCount,
+            qskDirtyItemCount( window ) - dirtyCount );
+    }
 }
 
 Q_GLOBAL_STATIC( QskAnimatorDriver, qskAnimatorDriver )
-Q_GLOBAL_STATIC( Statistics, qskStatistics )
 
 QskAnimator::QskAnimator()
     : m_window( nullptr )
     , m_duration( 200 )
     , m_startTime( -1 )
+    , m_driverIndex( -1 )
+{
+    if ( qskStatistics )
+        qskStatistics->increment();
+}
+
+QskAnimator::QskAnimator( const QskAnimator& other )
+    : m_window( other.m_window )
+    , m_duration( other.m_duration )
+    , m_easingCurve( other.m_easingCurve )
+    , m_startTime( -1 )
+    , m_driverIndex( -1 )
 {
+    // a copy is not running, even if the original is
+
     if ( qskStatistics )
         qskStatistics->increment();
 }
 
+QskAnimator& QskAnimator::operator=( const QskAnimator& other )
+{
+    if ( &other != this )
+    {
+        /*
+            The registration at the driver belongs to the animator
+            and is never taken over from the other one.
+         */
+        stop();
+
+        m_window = other.m_window;
+        m_duration = other.m_duration;
+        m_easingCurve = other.m_easingCurve;
+    }
+
+    return *this;
+}
+
 QskAnimator::~QskAnimator()
 {
     if ( qskAnimatorDriver )
@@ -376,6 +868,76 @@ QMetaObject::Connection QskAnimator::addAdvanceHandler(
         SIGNAL(advanced(QQuickWindow*)), receiver, method, type );
 }
 
+void QskAnimator::setClockType( ClockType type )
+{
+    if ( auto driver = qskAnimatorDriver )
+        driver->setClockType( type );
+}
+
+QskAnimator::ClockType QskAnimator::clockType()
+{
+    if ( auto driver = qskAnimatorDriver )
+        return driver->clockType();
+
+    return RealTime;
+}
+
+void QskAnimator::setClockStep( int ms )
+{
+    if ( auto driver = qskAnimatorDriver )
+        driver->setClockStep( ms );
+}
+
+int QskAnimator::clockStep()
+{
+    if ( auto driver = qskAnimatorDriver )
+        return driver->clockStep();
+
+    return 0;
+}
+
+void QskAnimator::advanceClock( int ms )
+{
+    if ( auto driver = qskAnimatorDriver )
+        driver->advanceClock( ms );
+}
+
+qint64 QskAnimator::clockTime()
+{
+    if ( auto driver = qskAnimatorDriver )
+        return driver->referenceTime();
+
+    return -1;
+}
+
+void QskAnimator::setFrameStatisticsEnabled( bool on )
+{
+    if ( qskStatistics )
+        qskStatistics->setFrameStatisticsEnabled( on );
+}
+
+bool QskAnimator::isFrameStatisticsEnabled()
+{
+    if ( qskStatistics )
+        return qskStatistics->isFrameStatisticsEnabled();
+
+    return false;
+}
+
+QskAnimator::FrameStatistics QskAnimator::frameStatistics( const QQuickWindow* window )
+{
+    if ( qskStatistics )
+        return qskStatistics->frameStatistics( window );
+
+    return FrameStatistics();
+}
+
+void QskAnimator::resetFrameStatistics()
+{
+    if ( qskStatistics )
+        qskStatistics->resetFrames();
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 
 void QskAnimator::debugStatistics( QDebug debug )
@@ -19,6 +19,10 @@ class QSK_EXPORT QskAnimator
     QskAnimator();
     virtual ~QskAnimator();
 
+    // copies the parameters, but not the state of a running animator
+    QskAnimator( const QskAnimator& );
+    QskAnimator& operator=( const QskAnimator& );
+
     QQuickWindow* window() const;
     void setWindow( QQuickWindow* );
 
@@ -45,6 +49,64 @@ class QSK_EXPORT QskAnimator
         QObject* receiver, const char* method,
         Qt::ConnectionType type = Qt::AutoConnection );
 
+    /*
+        By default the animators follow the wall clock. The virtual clock
+        advances by a fixed step for each frame instead, so that an animation
+        runs through the same sequence of values, whatever the frame rate is.
+        This is useful for benchmarks and rendering transitions headlessly.
+     */
+    enum ClockType
+    {
+        RealTime,
+        VirtualTime
+    };
+
+    static void setClockType( ClockType );
+    static ClockType clockType();
+
+    // the step ( in ms ) of the virtual clock for each frame
+    static void setClockStep( int ms );
+    static int clockStep();
+
+    // advancing the virtual clock manually
+    static void advanceClock( int ms );
+
+    // the current time in ms
+    static qint64 clockTime();
+
+    class FrameStatistics
+    {
+      public:
+        FrameStatistics();
+
+        int frames;        // advancing the animators of a window
+        int droppedFrames; // detected from the timestamps of frameSwapped
+
+        int animators;     // running animators in the last frame
+        int maxAnimators;
+
+        // time spent in advancing the animators in ns
+        qint64 advanceTime;
+        qint64 lastAdvanceTime;
+        qint64 maxAdvanceTime;
+
+        // items, that have been scheduled for polishing/updating
+        int polishes;
+        int updates;
+    };
+
+    /*
+        Collecting the frame statistics walks the dirty items of a window
+        twice per frame. So it is disabled by default and can be enabled
+        by setting QSK_ANIMATOR_STATISTICS or calling setFrameStatisticsEnabled.
+     */
+    static void setFrameStatisticsEnabled( bool );
+    static bool isFrameStatisticsEnabled();
+
+    // a nullptr for the statistics of all windows
+    static FrameStatistics frameStatistics( const QQuickWindow* = nullptr );
+    static void resetFrameStatistics();
+
 #ifndef QT_NO_DEBUG_STREAM
     static void debugStatistics( QDebug );
 #endif
@@ -55,13 +117,30 @@ class QSK_EXPORT QskAnimator
     virtual void done();
 
   private:
+    friend class QskAnimatorDriver;
+
     QQuickWindow* m_window;
 
     int m_duration;
     QEasingCurve m_easingCurve;
     qint64 m_startTime; // quint32 might be enough
+
+    int m_driverIndex; // position in the animators of the window
 };
 
+inline QskAnimator::FrameStatistics::FrameStatistics()
+    : frames( 0 )
+    , droppedFrames( 0 )
+    , animators( 0 )
+    , maxAnimators( 0 )
+    , advanceTime( 0 )
+    , lastAdvanceTime( 0 )
+    , maxAdvanceTime( 0 )
+    , polishes( 0 )
+    , updates( 0 )
+{
+}
+
 inline bool QskAnimator::isRunning() const
 {
     return m_startTime >= 0;
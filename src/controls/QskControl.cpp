@@ -13,7 +13,9 @@
 #include "QskSkin.h"
 #include "QskSkinlet.h"
 #include "QskSkinHintTable.h"
+#include "QskSkinTransition.h"
 #include "QskLayoutConstraint.h"
+#include "QskLayoutProfiler.h"
 
 #include <qglobalstatic.h>
 #include <qlocale.h>
@@ -368,6 +370,8 @@ void QskControlPrivate::updateImplicitSize( bool doNotify )
 {
     Q_Q( const QskControl );
 
+    QSK_LAYOUT_PROFILE( q, SizeHint );
+
     blockedImplicitSize = false;
 
     const auto m = q->margins();
@@ -542,6 +546,9 @@ QskControl::QskControl( QQuickItem* parent )
         qskFilterWindow( window() );
 
     qskRegistry->insert( this );
+
+    if ( window() )
+        QskSkinTransition::registerControl( this );
 }
 
 QskControl::~QskControl()
@@ -557,6 +564,8 @@ QskControl::~QskControl()
     if ( qskRegistry )
         qskRegistry->remove( this );
 
+    QskSkinTransition::unregisterControl( this );
+
 #if QT_VERSION < QT_VERSION_CHECK( 5, 10, 0 )
     disconnect( this, &QQuickItem::enabledChanged, nullptr, nullptr );
 #endif
@@ -1719,6 +1728,16 @@ void QskControl::itemChange( QQuickItem::ItemChange change,
             {
                 if ( d->controlFlags & QskControl::DeferredUpdate )
                     qskFilterWindow( value.window );
+
+                QskSkinTransition::registerControl( this );
+
+#if defined( QSK_LAYOUT_PROFILER )
+                QskLayoutProfiler::instance()->watchWindow( value.window );
+#endif
+            }
+            else
+            {
+                QskSkinTransition::unregisterControl( this );
             }
 
 #if 1
@@ -1796,6 +1815,8 @@ void QskControl::updatePolish()
 {
     Q_D( QskControl );
 
+    QSK_LAYOUT_PROFILE( this, Polish );
+
     if ( d->controlFlags & QskControl::DeferredPolish )
     {
         if ( !isVisible() )
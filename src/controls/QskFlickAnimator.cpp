@@ -6,6 +6,8 @@
 #include "QskFlickAnimator.h"
 #include <qmath.h>
 
+#include <cmath>
+
 static inline qreal qskAligned( qreal value )
 {
     if ( qFuzzyIsNull( value ) )
@@ -20,14 +22,49 @@ static inline qreal qskAligned( qreal value )
     return value;
 }
 
+/*
+    The velocity decays exponentially, but is shifted by the stop velocity,
+    so that it reaches 0 in finite time without jumping:
+
+        v( t ) = ( v0 + vs ) * exp( -t / tau ) - vs
+        s( t ) = ( v0 + vs ) * tau * ( 1 - exp( -t / tau ) ) - vs * t
+
+        T = tau * ln( ( v0 + vs ) / vs ), where v( T ) = 0
+ */
+
+static inline qreal qskFlickDuration( qreal velocity, qreal tau, qreal stopVelocity )
+{
+    return tau * std::log( ( velocity + stopVelocity ) / stopVelocity );
+}
+
+static inline qreal qskFlickVelocity(
+    qreal velocity, qreal tau, qreal stopVelocity, qreal time )
+{
+    return ( velocity + stopVelocity ) * std::exp( -time / tau ) - stopVelocity;
+}
+
+static inline qreal qskFlickDistance(
+    qreal velocity, qreal tau, qreal stopVelocity, qreal time )
+{
+    return ( velocity + stopVelocity ) * tau * ( 1.0 - std::exp( -time / tau ) )
+        - stopVelocity * time;
+}
+
 QskFlickAnimator::QskFlickAnimator()
     : m_velocity{ 0.0, 0.0 }
     , m_degrees( 0.0 )
     , m_cos( 1.0 )
     , m_sin( 0.0 )
+    , m_timeConstant( 0.325 )
+    , m_stopVelocity( 20.0 )
+    , m_distance( 0.0 )
+    , m_flickDuration( 0.0 )
+    , m_isDurationDerived( false )
 {
-    setDuration( 1000 );
-    setEasingCurve( QEasingCurve::OutCubic );
+    // derived from the velocity, when starting
+    setDuration( -1 );
+
+    setEasingCurve( QEasingCurve::Linear );
 }
 
 QskFlickAnimator::~QskFlickAnimator()
@@ -83,7 +120,18 @@ void QskFlickAnimator::accelerate( qreal degrees, qreal velocity )
 void QskFlickAnimator::done()
 {
     m_velocity[ 1 ] = 0.0;
-    m_elapsed = 0.0;
+    m_distance = 0.0;
+
+    if ( m_isDurationDerived )
+    {
+        // the duration for the next flick has to be derived again,
+        // unless it has been set explicitly meanwhile
+
+        if ( duration() == flickDuration() )
+            setDuration( -1 );
+
+        m_isDurationDerived = false;
+    }
 }
 
 void QskFlickAnimator::setAngle( qreal degrees )
@@ -104,31 +152,66 @@ void QskFlickAnimator::setVelocity( qreal velocity )
     m_velocity[ 0 ] = velocity;
 }
 
+void QskFlickAnimator::setTimeConstant( int ms )
+{
+    m_timeConstant = qMax( ms, 1 ) / 1000.0;
+}
+
+int QskFlickAnimator::timeConstant() const
+{
+    return qRound( 1000.0 * m_timeConstant );
+}
+
+void QskFlickAnimator::setStopVelocity( qreal velocity )
+{
+    // with 0.0 the movement would never stop
+    m_stopVelocity = qMax( velocity, 1.0 );
+}
+
+int QskFlickAnimator::flickDuration() const
+{
+    const qreal duration = qskFlickDuration(
+        qMax( m_velocity[ 0 ], 0.0 ), m_timeConstant, m_stopVelocity );
+
+    return qMax( qCeil( 1000.0 * duration ), 1 );
+}
+
 void QskFlickAnimator::setup()
 {
-    m_elapsed = 0;
+    m_distance = 0.0;
     m_velocity[ 1 ] = m_velocity[ 0 ];
+
+    m_flickDuration = qskFlickDuration(
+        qMax( m_velocity[ 0 ], 0.0 ), m_timeConstant, m_stopVelocity );
+
+    // an explicit duration is respected
+    m_isDurationDerived = ( duration() <= 0 );
+    if ( m_isDurationDerived )
+        setDuration( flickDuration() );
 }
 
 void QskFlickAnimator::advance( qreal value )
 {
-    const qreal oldVelocity = m_velocity[ 1 ];
-    const int oldElapsed = m_elapsed;
+    /*
+        The progress is derived from the reference time of the driver,
+        so the distance is always in sync with the frame being rendered,
+        even when frames have been dropped.
 
-    m_velocity[ 1 ] = m_velocity[ 0 ] * ( 1.0 - value );
-    m_elapsed = elapsed();
+        Easing curves might overshoot, but the movement does
+        not go beyond the point, where the velocity is 0.
+     */
+    value = qBound( qreal( 0.0 ), value, qreal( 1.0 ) );
+    const qreal time = value * m_flickDuration; // in seconds
 
-    const qreal duration = ( m_elapsed - oldElapsed ) / 1000.0; // in seconds
-    if ( duration > 0.0 )
-    {
-        const qreal velocity = 0.5 * ( m_velocity[ 1 ] + oldVelocity ); // average
+    m_velocity[ 1 ] = qMax( 0.0, qskFlickVelocity(
+        m_velocity[ 0 ], m_timeConstant, m_stopVelocity, time ) );
 
-        /*
-            Using the average velocity is not accurate, when having a non linear
-            curve, but the error can be ignored
-         */
+    const qreal distance = qskFlickDistance(
+        m_velocity[ 0 ], m_timeConstant, m_stopVelocity, time );
 
-        const qreal distance = duration * velocity;
-        translate( m_cos * distance, m_sin * distance );
-    }
+    const qreal delta = distance - m_distance;
+    m_distance = distance;
+
+    if ( delta != 0.0 )
+        translate( m_cos * delta, m_sin * delta );
 }
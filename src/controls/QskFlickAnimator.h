@@ -8,6 +8,21 @@
 
 #include "QskAnimator.h"
 
+/*
+    QskFlickAnimator implements a kinetic movement, where the velocity
+    decays exponentially - like being slowed down by friction - until it
+    reaches zero.
+
+    The translation of each frame is calculated from the distance, that has
+    been travelled since the flick has been started. So the total distance
+    does not depend on the frame rate or on frames being dropped.
+
+    By default ( duration() <= 0 ) the duration is calculated from the
+    initial velocity, when starting. An explicit duration stretches or
+    compresses the same movement in time, and the easing curve
+    - linear by default - maps the progress of the animator to the
+    time of the movement.
+ */
 class QSK_EXPORT QskFlickAnimator : public QskAnimator
 {
   public:
@@ -22,9 +37,20 @@ class QSK_EXPORT QskFlickAnimator : public QskAnimator
 
     qreal animatedVelocity() const;
 
+    // time in ms, where the velocity decays to 1/e
+    void setTimeConstant( int ms );
+    int timeConstant() const;
+
+    // pixels per second
+    void setStopVelocity( qreal );
+    qreal stopVelocity() const;
+
     void flick( qreal degrees, qreal velocity );
     void accelerate( qreal degrees, qreal velocity );
 
+    // time in ms, until the velocity has decayed to 0
+    int flickDuration() const;
+
   protected:
     void setup() override;
     void advance( qreal value ) override final;
@@ -39,7 +65,13 @@ class QSK_EXPORT QskFlickAnimator : public QskAnimator
     qreal m_cos;
     qreal m_sin;
 
-    int m_elapsed;
+    qreal m_timeConstant; // in seconds
+    qreal m_stopVelocity;
+
+    qreal m_distance; // travelled since the flick has been started
+
+    qreal m_flickDuration; // in seconds, from the initial velocity
+    bool m_isDurationDerived;
 };
 
 inline qreal QskFlickAnimator::angle() const
@@ -57,4 +89,9 @@ inline qreal QskFlickAnimator::animatedVelocity() const
     return m_velocity[ 1 ];
 }
 
+inline qreal QskFlickAnimator::stopVelocity() const
+{
+    return m_stopVelocity;
+}
+
 #endif
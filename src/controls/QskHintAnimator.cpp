@@ -9,10 +9,11 @@
 #include "QskEvent.h"
 
 #include <qobject.h>
+#include <qpointer.h>
 #include <qthread.h>
 
 #include <algorithm>
-#include <map>
+#include <memory>
 #include <vector>
 
 #define ALIGN_VALUES 0
@@ -93,6 +94,43 @@ static inline bool qskCheckReceiverThread( const QObject* receiver )
     return ( thread == QThread::currentThread() );
 }
 
+namespace
+{
+    class Termination
+    {
+      public:
+        // the control might be deleted, while notifying the others
+        QPointer< QskControl > control;
+        QskAspect::Aspect aspect;
+    };
+}
+
+static void qskSendTerminated( const std::vector< Termination >& terminations )
+{
+    for ( const auto& termination : terminations )
+    {
+        const auto control = termination.control.data();
+
+        if ( control && qskCheckReceiverThread( control ) )
+        {
+            QskAnimatorEvent event( termination.aspect, QskAnimatorEvent::Terminated );
+            QCoreApplication::sendEvent( control, &event );
+        }
+    }
+}
+
+static void qskPostTerminated( const std::vector< Termination >& terminations )
+{
+    for ( const auto& termination : terminations )
+    {
+        if ( const auto control = termination.control.data() )
+        {
+            QCoreApplication::postEvent( control,
+                new QskAnimatorEvent( termination.aspect, QskAnimatorEvent::Terminated ) );
+        }
+    }
+}
+
 QskHintAnimator::QskHintAnimator()
 {
 }
@@ -163,12 +201,18 @@ namespace
       private Q_SLOTS:
         void cleanup()
         {
-            for ( auto it = m_tables.begin(); it != m_tables.end(); )
+            /*
+                The controls, that are notified about terminated animators,
+                might start new transitions or delete themselves, what
+                registers/unregisters tables. So we iterate over a copy and
+                each table unregisters itself, when being empty.
+             */
+            const auto tables = m_tables;
+
+            for ( auto table : tables )
             {
-                if ( ( *it )->cleanup() )
-                    it = m_tables.erase( it );
-                else
-                    ++it;
+                if ( std::binary_search( m_tables.begin(), m_tables.end(), table ) )
+                    table->cleanup();
             }
         }
 
@@ -183,9 +227,124 @@ namespace
 class QskHintAnimatorTable::PrivateData
 {
   public:
-    // we won't have many entries, so we prefer less memory over
-    // using a hash table
-    std::map< QskAspect::Aspect, QskHintAnimator > map;
+    /*
+        Usually we have only a few animators running at the same time,
+        so they are stored inline with the table. As they are registered
+        by their address, they must not be moved while running. So
+        the slots are never compacted and only the - rare - animators
+        beyond the inline capacity are allocated individually.
+     */
+    enum
+    {
+        InlineCapacity = 4
+    };
+
+    PrivateData()
+        : inlineCount( 0 )
+    {
+        for ( auto& isUsed : used )
+            isUsed = false;
+    }
+
+    QskHintAnimator* find( QskAspect::Aspect aspect )
+    {
+        for ( int i = 0; i < InlineCapacity; i++ )
+        {
+            if ( used[ i ] && animators[ i ].aspect() == aspect )
+                return &animators[ i ];
+        }
+
+        for ( const auto& animator : overflow )
+        {
+            if ( animator->aspect() == aspect )
+                return animator.get();
+        }
+
+        return nullptr;
+    }
+
+    QskHintAnimator* insert( QskAspect::Aspect aspect )
+    {
+        QskHintAnimator* animator = nullptr;
+
+        if ( inlineCount < InlineCapacity )
+        {
+            for ( int i = 0; i < InlineCapacity; i++ )
+            {
+                if ( !used[ i ] )
+                {
+                    used[ i ] = true;
+                    inlineCount++;
+
+                    animator = &animators[ i ];
+                    break;
+                }
+            }
+        }
+        else
+        {
+            overflow.emplace_back( new QskHintAnimator() );
+            animator = overflow.back().get();
+        }
+
+        animator->setAspect( aspect );
+        return animator;
+    }
+
+    /*
+        The terminations are only collected, so that the table is
+        in a consistent state, before the controls are notified.
+     */
+    void removeTerminated( std::vector< Termination >& terminations )
+    {
+        for ( int i = 0; i < InlineCapacity; i++ )
+        {
+            if ( used[ i ] && !animators[ i ].isRunning() )
+            {
+                auto& animator = animators[ i ];
+
+                terminations.push_back( { animator.control(), animator.aspect() } );
+
+                // releasing the values
+                animator.setStartValue( QVariant() );
+                animator.setEndValue( QVariant() );
+                animator.setCurrentValue( QVariant() );
+                animator.setControl( nullptr );
+
+                used[ i ] = false;
+                inlineCount--;
+            }
+        }
+
+        for ( auto it = overflow.begin(); it != overflow.end(); )
+        {
+            if ( !( *it )->isRunning() )
+            {
+                terminations.push_back( { ( *it )->control(), ( *it )->aspect() } );
+                it = overflow.erase( it );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    inline bool isFull() const
+    {
+        return inlineCount == InlineCapacity;
+    }
+
+    inline bool isEmpty() const
+    {
+        return ( inlineCount == 0 ) && overflow.empty();
+    }
+
+    QskHintAnimator animators[ InlineCapacity ];
+    bool used[ InlineCapacity ];
+    int inlineCount;
+
+    std::vector< std::unique_ptr< QskHintAnimator > > overflow;
 };
 
 QskHintAnimatorTable::QskHintAnimatorTable()
@@ -211,19 +370,36 @@ void QskHintAnimatorTable::start( QskControl* control,
         qskAnimatorGuard->registerTable( this );
     }
 
-    auto& animator = m_data->map[ aspect ];
+    auto animator = m_data->find( aspect );
+    if ( animator == nullptr )
+    {
+        /*
+            Before allocating beyond the inline capacity we drop the
+            terminated animators right away instead of waiting for
+            the next cleanup. The controls are notified later, as
+            they must not be entered while starting a transition.
+         */
+        if ( m_data->isFull() )
+        {
+            std::vector< Termination > terminations;
+            m_data->removeTerminated( terminations );
 
-    animator.setAspect( aspect );
-    animator.setStartValue( from );
-    animator.setEndValue( to );
+            qskPostTerminated( terminations );
+        }
+
+        animator = m_data->insert( aspect );
+    }
 
-    animator.setDuration( animationHint.duration );
-    animator.setEasingCurve( animationHint.type );
+    animator->setStartValue( from );
+    animator->setEndValue( to );
 
-    animator.setControl( control );
-    animator.setWindow( control->window() );
+    animator->setDuration( animationHint.duration );
+    animator->setEasingCurve( animationHint.type );
 
-    animator.start();
+    animator->setControl( control );
+    animator->setWindow( control->window() );
+
+    animator->start();
 
     if ( qskCheckReceiverThread( control ) )
     {
@@ -237,23 +413,17 @@ const QskHintAnimator* QskHintAnimatorTable::animator( QskAspect::Aspect aspect
     if ( m_data == nullptr )
         return nullptr;
 
-    auto it = m_data->map.find( aspect );
-    if ( it == m_data->map.end() )
-        return nullptr;
-
-    return &( it->second );
+    return m_data->find( aspect );
 }
 
 QVariant QskHintAnimatorTable::currentValue( QskAspect::Aspect aspect ) const
 {
     if ( m_data )
     {
-        const auto it = m_data->map.find( aspect );
-        if ( it != m_data->map.cend() )
+        if ( const auto animator = m_data->find( aspect ) )
         {
-            const auto& animator = it->second;
-            if ( animator.isRunning() )
-                return animator.currentValue();
+            if ( animator->isRunning() )
+                return animator->currentValue();
         }
     }
 
@@ -265,40 +435,27 @@ bool QskHintAnimatorTable::cleanup()
     if ( m_data == nullptr )
         return true;
 
-    for ( auto it = m_data->map.begin(); it != m_data->map.end(); )
-    {
-        // remove all terminated animators
-        if ( !it->second.isRunning() )
-        {
-            auto control = it->second.control();
-            auto aspect = it->first;
-
-            it = m_data->map.erase( it );
+    // remove all terminated animators
 
-            if ( control )
-            {
-                if ( qskCheckReceiverThread( control ) )
-                {
-                    QskAnimatorEvent event( aspect, QskAnimatorEvent::Terminated );
-                    QCoreApplication::sendEvent( control, &event );
-                }
-            }
-        }
-        else
-        {
-            ++it;
-        }
-    }
+    std::vector< Termination > terminations;
+    m_data->removeTerminated( terminations );
 
-    if ( m_data->map.empty() )
+    const bool isEmpty = m_data->isEmpty();
+    if ( isEmpty )
     {
         delete m_data;
         m_data = nullptr;
 
-        return true;
+        qskAnimatorGuard->unregisterTable( this );
     }
 
-    return false;
+    /*
+        The table might be modified or even deleted, when
+        notifying the controls. So we must not touch it afterwards.
+     */
+    qskSendTerminated( terminations );
+
+    return isEmpty;
 }
 
 #include "QskHintAnimator.moc"
@@ -0,0 +1,375 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskLayoutProfiler.h"
+
+#include <qcoreapplication.h>
+#include <qelapsedtimer.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qquickitem.h>
+#include <qquickwindow.h>
+#include <qvector.h>
+
+#ifndef QT_NO_DEBUG_STREAM
+#include <qdebug.h>
+#endif
+
+namespace
+{
+    /*
+        Every event costs an allocation for the object name,
+        so we stop recording events after reaching this limit.
+        The counters are updated anyway.
+     */
+    const int qskMaxEvents = 500000;
+
+    class Event
+    {
+      public:
+        const char* className;
+        QString objectName;
+        quintptr id;
+
+        QskLayoutProfiler::Activity activity;
+        int frame;
+
+        qint64 startTime; // nanoseconds
+        qint64 duration;
+    };
+
+    class Counter
+    {
+      public:
+        inline Counter()
+        {
+            reset();
+        }
+
+        inline void reset()
+        {
+            count = 0;
+            duration = 0;
+        }
+
+        inline void add( qint64 nsecs )
+        {
+            count++;
+            duration += nsecs;
+        }
+
+        int count;
+        qint64 duration;
+    };
+
+    class Frame
+    {
+      public:
+        Counter counters[ QskLayoutProfiler::ActivityCount ];
+        Counter lastCounters[ QskLayoutProfiler::ActivityCount ];
+    };
+}
+
+static const char* qskActivityName( QskLayoutProfiler::Activity activity )
+{
+    static const char* names[] =
+    {
+        "polish",
+        "layout",
+        "geometries",
+        "sizeHint",
+        "invalidation",
+        "propagation"
+    };
+
+    return names[ activity ];
+}
+
+class QskLayoutProfiler::PrivateData
+{
+  public:
+    PrivateData()
+        : isActive( true )
+        , frame( 0 )
+    {
+        timer.start();
+
+        for ( auto& count : maximumFrameCounts )
+            count = 0;
+    }
+
+    bool isActive;
+    int frame;
+
+    QElapsedTimer timer;
+
+    Counter counters[ ActivityCount ];
+    int maximumFrameCounts[ ActivityCount ];
+
+    QHash< const QQuickWindow*, Frame > frames;
+
+    QVector< Event > events;
+};
+
+QskLayoutProfiler::Scope::Scope(
+        const QObject* object, QskLayoutProfiler::Activity activity )
+    : m_object( object )
+    , m_activity( activity )
+    , m_startTime( QskLayoutProfiler::instance()->isActive()
+        ? QskLayoutProfiler::instance()->m_data->timer.nsecsElapsed() : -1 )
+{
+}
+
+QskLayoutProfiler::Scope::~Scope()
+{
+    if ( m_startTime >= 0 )
+        QskLayoutProfiler::instance()->record( m_object, m_activity, m_startTime );
+}
+
+QskLayoutProfiler::QskLayoutProfiler()
+    : m_data( new PrivateData() )
+{
+}
+
+QskLayoutProfiler::~QskLayoutProfiler()
+{
+}
+
+QskLayoutProfiler* QskLayoutProfiler::instance()
+{
+    static QskLayoutProfiler profiler;
+    return &profiler;
+}
+
+void QskLayoutProfiler::setActive( bool on )
+{
+    m_data->isActive = on;
+}
+
+bool QskLayoutProfiler::isActive() const
+{
+    return m_data->isActive;
+}
+
+void QskLayoutProfiler::watchWindow( const QQuickWindow* window )
+{
+    if ( window == nullptr || m_data->frames.contains( window ) )
+        return;
+
+    m_data->frames.insert( window, Frame() );
+
+    // the polish cycle of a frame follows afterAnimating
+
+    connect( window, &QQuickWindow::afterAnimating,
+        this, [ this, window ]() { beginFrame( window ); } );
+
+    connect( window, &QObject::destroyed,
+        this, [ this, window ]() { removeWindow( window ); } );
+}
+
+void QskLayoutProfiler::removeWindow( const QQuickWindow* window )
+{
+    m_data->frames.remove( window );
+}
+
+void QskLayoutProfiler::reset()
+{
+    m_data->frame = 0;
+
+    for ( int i = 0; i < ActivityCount; i++ )
+    {
+        m_data->counters[ i ].reset();
+        m_data->maximumFrameCounts[ i ] = 0;
+    }
+
+    for ( auto& frame : m_data->frames )
+    {
+        for ( int i = 0; i < ActivityCount; i++ )
+        {
+            frame.counters[ i ].reset();
+            frame.lastCounters[ i ].reset();
+        }
+    }
+
+    m_data->events.clear();
+}
+
+int QskLayoutProfiler::frameCount() const
+{
+    return m_data->frame;
+}
+
+int QskLayoutProfiler::count( Activity activity ) const
+{
+    return m_data->counters[ activity ].count;
+}
+
+qint64 QskLayoutProfiler::duration( Activity activity ) const
+{
+    return m_data->counters[ activity ].duration / 1000;
+}
+
+int QskLayoutProfiler::frameCount(
+    const QQuickWindow* window, Activity activity ) const
+{
+    const auto it = m_data->frames.constFind( window );
+    if ( it == m_data->frames.constEnd() )
+        return 0;
+
+    return it->lastCounters[ activity ].count;
+}
+
+qint64 QskLayoutProfiler::frameDuration(
+    const QQuickWindow* window, Activity activity ) const
+{
+    const auto it = m_data->frames.constFind( window );
+    if ( it == m_data->frames.constEnd() )
+        return 0;
+
+    return it->lastCounters[ activity ].duration / 1000;
+}
+
+int QskLayoutProfiler::maximumFrameCount( Activity activity ) const
+{
+    return m_data->maximumFrameCounts[ activity ];
+}
+
+void QskLayoutProfiler::beginFrame( const QQuickWindow* window )
+{
+    if ( !m_data->isActive )
+        return;
+
+    auto it = m_data->frames.find( window );
+    if ( it == m_data->frames.end() )
+        return;
+
+    for ( int i = 0; i < ActivityCount; i++ )
+    {
+        it->lastCounters[ i ] = it->counters[ i ];
+        it->counters[ i ].reset();
+    }
+
+    m_data->frame++;
+}
+
+void QskLayoutProfiler::record(
+    const QObject* object, Activity activity, qint64 startTime )
+{
+    const auto duration = m_data->timer.nsecsElapsed() - startTime;
+
+    m_data->counters[ activity ].add( duration );
+
+    const QQuickWindow* window = nullptr;
+    if ( auto item = qobject_cast< const QQuickItem* >( object ) )
+        window = item->window();
+
+    auto it = m_data->frames.find( window );
+    if ( it != m_data->frames.end() )
+    {
+        auto& counter = it->counters[ activity ];
+        counter.add( duration );
+
+        if ( counter.count > m_data->maximumFrameCounts[ activity ] )
+            m_data->maximumFrameCounts[ activity ] = counter.count;
+    }
+
+    if ( m_data->events.size() < qskMaxEvents )
+    {
+        Event event;
+        event.className = object ? object->metaObject()->className() : "";
+        event.objectName = object ? object->objectName() : QString();
+        event.id = reinterpret_cast< quintptr >( object );
+        event.activity = activity;
+        event.frame = m_data->frame;
+        event.startTime = startTime;
+        event.duration = duration;
+
+        m_data->events += event;
+    }
+}
+
+bool QskLayoutProfiler::writeTrace( QIODevice* device ) const
+{
+    /*
+        The "Trace Event Format" of the Chrome tracing tools:
+        each calculation is a complete event ( "ph": "X" ), timestamps
+        and durations are in microseconds.
+     */
+
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QJsonArray traceEvents;
+
+    for ( const auto& event : qAsConst( m_data->events ) )
+    {
+        QString name = QLatin1String( event.className );
+        if ( !event.objectName.isEmpty() )
+            name += QStringLiteral( " \"%1\"" ).arg( event.objectName );
+
+        QJsonObject args;
+        args[ QStringLiteral( "frame" ) ] = event.frame;
+        args[ QStringLiteral( "object" ) ] =
+            QStringLiteral( "0x%1" ).arg( event.id, 0, 16 );
+
+        QJsonObject traceEvent;
+        traceEvent[ QStringLiteral( "name" ) ] = name;
+        traceEvent[ QStringLiteral( "cat" ) ] =
+            QLatin1String( qskActivityName( event.activity ) );
+        traceEvent[ QStringLiteral( "ph" ) ] = QStringLiteral( "X" );
+        traceEvent[ QStringLiteral( "ts" ) ] = event.startTime / 1000.0;
+        traceEvent[ QStringLiteral( "dur" ) ] = event.duration / 1000.0;
+        traceEvent[ QStringLiteral( "pid" ) ] = pid;
+        traceEvent[ QStringLiteral( "tid" ) ] = 0;
+        traceEvent[ QStringLiteral( "args" ) ] = args;
+
+        traceEvents += traceEvent;
+    }
+
+    QJsonObject trace;
+    trace[ QStringLiteral( "traceEvents" ) ] = traceEvents;
+    trace[ QStringLiteral( "displayTimeUnit" ) ] = QStringLiteral( "ms" );
+
+    const auto data = QJsonDocument( trace ).toJson( QJsonDocument::Compact );
+    return device->write( data ) == data.size();
+}
+
+bool QskLayoutProfiler::writeTrace( const QString& fileName ) const
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+        qWarning( "QskLayoutProfiler::writeTrace can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    return writeTrace( &file );
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+void QskLayoutProfiler::debugStatistics( QDebug debug ) const
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "frames: " << m_data->frame;
+
+    for ( int i = 0; i < ActivityCount; i++ )
+    {
+        const auto activity = static_cast< Activity >( i );
+
+        debug << ", " << qskActivityName( activity ) << ": ("
+              << "count: " << count( activity )
+              << ", us: " << duration( activity )
+              << ", maximum per frame: " << maximumFrameCount( activity ) << ')';
+    }
+}
+
+#endif
+
+#include "moc_QskLayoutProfiler.cpp"
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_LAYOUT_PROFILER_H
+#define QSK_LAYOUT_PROFILER_H
+
+#include "QskGlobal.h"
+#include <qobject.h>
+#include <memory>
+
+class QQuickWindow;
+class QIODevice;
+class QString;
+class QDebug;
+
+/*
+    QskLayoutProfiler records the polish, layout and size hint
+    calculations of the controls, so that they can be inspected
+    in a trace viewer ( chrome://tracing, https://ui.perfetto.dev ).
+    Invalidations of the layout boxes and the propagations
+    to their parents are recorded as well.
+
+    The counters of a frame are kept for each window.
+
+    The hooks in QskControl and the layout classes are only compiled
+    when building with QSK_CONFIG += QskLayoutProfiler. Otherwise
+    QSK_LAYOUT_PROFILE expands to nothing.
+ */
+
+class QSK_EXPORT QskLayoutProfiler : public QObject
+{
+    Q_OBJECT
+
+  public:
+    enum Activity
+    {
+        Polish,
+        Layout,
+        Geometries,
+        SizeHint,
+        Invalidation,
+        Propagation,
+
+        ActivityCount
+    };
+
+    Q_ENUM( Activity )
+
+    class Scope
+    {
+      public:
+        Scope( const QObject*, Activity );
+        ~Scope();
+
+      private:
+        const QObject* m_object;
+        const Activity m_activity;
+        const qint64 m_startTime;
+    };
+
+    static QskLayoutProfiler* instance();
+
+    void setActive( bool );
+    bool isActive() const;
+
+    void watchWindow( const QQuickWindow* );
+
+    void reset();
+
+    int frameCount() const;
+
+    int count( Activity ) const;
+    qint64 duration( Activity ) const; // in microseconds
+
+    // during the last frame of a window
+    int frameCount( const QQuickWindow*, Activity ) const;
+    qint64 frameDuration( const QQuickWindow*, Activity ) const;
+
+    // maximum count during a frame of any window
+    int maximumFrameCount( Activity ) const;
+
+    bool writeTrace( QIODevice* ) const;
+    bool writeTrace( const QString& fileName ) const;
+
+#ifndef QT_NO_DEBUG_STREAM
+    void debugStatistics( QDebug ) const;
+#endif
+
+  private:
+    QskLayoutProfiler();
+    ~QskLayoutProfiler() override;
+
+    void beginFrame( const QQuickWindow* );
+    void removeWindow( const QQuickWindow* );
+
+    void record( const QObject*, Activity, qint64 startTime );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#if defined( QSK_LAYOUT_PROFILER )
+
+#define QSK_LAYOUT_PROFILE( object, activity ) \
+    const QskLayoutProfiler::Scope qskLayoutProfileScope( \
+        object, QskLayoutProfiler::activity )
+
+#else
+
+#define QSK_LAYOUT_PROFILE( object, activity )
+
+#endif
+
+#endif
@@ -7,28 +7,179 @@
 #include "QskAspect.h"
 #include "QskColorFilter.h"
 
+#include <qmath.h>
+#include <qpair.h>
+#include <qvector.h>
+
 QSK_SUBCONTROL( QskListView, Cell )
 QSK_SUBCONTROL( QskListView, Text )
 QSK_SUBCONTROL( QskListView, CellSelected )
 QSK_SUBCONTROL( QskListView, TextSelected )
 
+namespace
+{
+    /*
+        A Fenwick tree of the row heights, offering to find the position
+        of a row and the row at a position in O(log n).
+     */
+    class RowIndex
+    {
+      public:
+        void reset( const QskListView* listView )
+        {
+            const int count = listView->rowCount();
+
+            m_heights.resize( count );
+            m_tree.fill( 0.0, count + 1 );
+
+            for ( int i = 0; i < count; i++ )
+            {
+                m_heights[ i ] = listView->rowHeightAt( i );
+                m_tree[ i + 1 ] += m_heights[ i ];
+
+                const int j = ( i + 1 ) + ( ( i + 1 ) & -( i + 1 ) );
+                if ( j <= count )
+                    m_tree[ j ] += m_tree[ i + 1 ];
+            }
+        }
+
+        void clear()
+        {
+            m_heights.clear();
+            m_tree.clear();
+        }
+
+        inline int count() const
+        {
+            return m_heights.size();
+        }
+
+        void setHeight( int row, qreal height )
+        {
+            const qreal delta = height - m_heights[ row ];
+            if ( delta == 0.0 )
+                return;
+
+            m_heights[ row ] = height;
+
+            for ( int i = row + 1; i < m_tree.size(); i += i & -i )
+                m_tree[ i ] += delta;
+        }
+
+        inline qreal height( int row ) const
+        {
+            return m_heights[ row ];
+        }
+
+        qreal offset( int row ) const
+        {
+            // sum of the heights of all rows before row
+            qreal y = 0.0;
+
+            for ( int i = qMin( row, count() ); i > 0; i -= i & -i )
+                y += m_tree[ i ];
+
+            return y;
+        }
+
+        int rowAt( qreal y ) const
+        {
+            int row = 0;
+
+            int step = 1;
+            while ( ( step << 1 ) <= count() )
+                step <<= 1;
+
+            for ( ; step > 0; step >>= 1 )
+            {
+                const int i = row + step;
+                if ( i <= count() && m_tree[ i ] <= y )
+                {
+                    row = i;
+                    y -= m_tree[ i ];
+                }
+            }
+
+            return row;
+        }
+
+        inline qreal totalHeight() const
+        {
+            return offset( count() );
+        }
+
+      private:
+        QVector< qreal > m_heights;
+        QVector< qreal > m_tree;
+    };
+}
+
+static inline qreal qskRowHeight(
+    const QskListView* listView, const RowIndex& rowIndex, int row )
+{
+    if ( listView->uniformRowHeights() )
+        return listView->rowHeight();
+
+    // the rows might have changed since the index has been built
+    return ( row < rowIndex.count() )
+        ? rowIndex.height( row ) : listView->rowHeightAt( row );
+}
+
 class QskListView::PrivateData
 {
   public:
     PrivateData()
         : preferredWidthFromColumns( false )
         , alternatingRowColors( false )
+        , uniformRowHeights( true )
+        , incrementalUpdates( false )
+        , allRowsDirty( true )
+        , rowHeightsDirty( true )
         , selectionMode( QskListView::SingleSelection )
         , selectedRow( -1 )
+        , prefetchRows( 2 )
     {
     }
 
+    void addDirtyRows( int from, int to )
+    {
+        if ( allRowsDirty )
+            return;
+
+        // merging overlapping or adjacent ranges
+
+        for ( int i = dirtyRows.size() - 1; i >= 0; i-- )
+        {
+            const auto& range = dirtyRows[ i ];
+
+            if ( from <= range.second + 1 && to >= range.first - 1 )
+            {
+                from = qMin( from, range.first );
+                to = qMax( to, range.second );
+
+                dirtyRows.remove( i );
+            }
+        }
+
+        dirtyRows += qMakePair( from, to );
+    }
+
     QskTextOptions textOptions;
     bool preferredWidthFromColumns : 1;
     bool alternatingRowColors : 1;
+    bool uniformRowHeights : 1;
+    bool incrementalUpdates : 1;
+    bool allRowsDirty : 1;
+    bool rowHeightsDirty : 1;
     SelectionMode selectionMode : 4;
 
     int selectedRow;
+    int prefetchRows;
+
+    RowIndex rowIndex;
+
+    // rows, that have been changed since the last update of the nodes
+    QVector< QPair< int, int > > dirtyRows;
 };
 
 QskListView::QskListView( QQuickItem* parent )
@@ -78,6 +229,9 @@ void QskListView::setTextOptions( const QskTextOptions& textOptions )
     if ( textOptions != m_data->textOptions )
     {
         m_data->textOptions = textOptions;
+        m_data->allRowsDirty = true;
+        m_data->rowHeightsDirty = true;
+
         updateScrollableSize();
 
         Q_EMIT textOptionsChanged();
@@ -89,6 +243,91 @@ QskTextOptions QskListView::textOptions() const
     return m_data->textOptions;
 }
 
+void QskListView::setUniformRowHeights( bool on )
+{
+    if ( on != m_data->uniformRowHeights )
+    {
+        m_data->uniformRowHeights = on;
+
+        if ( on )
+            m_data->rowIndex.clear();
+        else
+            m_data->rowHeightsDirty = true;
+
+        updateScrollableSize();
+        update();
+
+        Q_EMIT uniformRowHeightsChanged();
+    }
+}
+
+bool QskListView::uniformRowHeights() const
+{
+    return m_data->uniformRowHeights;
+}
+
+void QskListView::setPrefetchRows( int count )
+{
+    count = qMax( count, 0 );
+
+    if ( count != m_data->prefetchRows )
+    {
+        m_data->prefetchRows = count;
+        update();
+
+        Q_EMIT prefetchRowsChanged();
+    }
+}
+
+int QskListView::prefetchRows() const
+{
+    return m_data->prefetchRows;
+}
+
+qreal QskListView::rowHeightAt( int row ) const
+{
+    Q_UNUSED( row );
+    return rowHeight();
+}
+
+qreal QskListView::rowOffset( int row ) const
+{
+    if ( m_data->uniformRowHeights )
+        return row * rowHeight();
+
+    return m_data->rowIndex.offset( row );
+}
+
+int QskListView::rowAt( qreal y ) const
+{
+    if ( y < 0.0 )
+        return -1;
+
+    int row;
+
+    if ( m_data->uniformRowHeights )
+    {
+        const qreal h = rowHeight();
+        row = ( h > 0.0 ) ? qFloor( y / h ) : 0;
+    }
+    else
+    {
+        row = m_data->rowIndex.rowAt( y );
+    }
+
+    return ( row < rowCount() ) ? row : -1;
+}
+
+void QskListView::scrollToRow( int row )
+{
+    if ( row < 0 || row >= rowCount() )
+        return;
+
+    const qreal rowHeight = qskRowHeight( this, m_data->rowIndex, row );
+
+    ensureVisible( QRectF( scrollPos().x(), rowOffset( row ), 0.0, rowHeight ) );
+}
+
 void QskListView::setSelectedRow( int row )
 {
     if ( row < 0 )
@@ -110,6 +349,13 @@ void QskListView::setSelectedRow( int row )
 
     if ( row != m_data->selectedRow )
     {
+        // the text subcontrol of the cells depends on the selection
+        if ( m_data->selectedRow >= 0 )
+            m_data->addDirtyRows( m_data->selectedRow, m_data->selectedRow );
+
+        if ( row >= 0 )
+            m_data->addDirtyRows( row, row );
+
         m_data->selectedRow = row;
         Q_EMIT selectedRowChanged( row );
 
@@ -225,7 +471,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
     {
         auto pos = scrollPos();
 
-        const qreal rowPos = row * rowHeight();
+        const qreal rowPos = rowOffset( row );
+        const qreal rowHeight = qskRowHeight( this, m_data->rowIndex, row );
+
         if ( rowPos < scrollPos().y() )
         {
             pos.setY( rowPos );
@@ -235,9 +483,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
             const QRectF vr = viewContentsRect();
 
             const double scrolledBottom = scrollPos().y() + vr.height();
-            if ( rowPos + rowHeight() > scrolledBottom )
+            if ( rowPos + rowHeight > scrolledBottom )
             {
-                const double y = rowPos + rowHeight() - vr.height();
+                const double y = rowPos + rowHeight - vr.height();
                 pos.setY( y );
             }
         }
@@ -264,8 +512,8 @@ void QskListView::mousePressEvent( QMouseEvent* event )
         const QRectF vr = viewContentsRect();
         if ( vr.contains( event->pos() ) )
         {
-            const int row = ( event->pos().y() - vr.top() + scrollPos().y() ) / rowHeight();
-            if ( row >= 0 && row < rowCount() )
+            const int row = rowAt( event->pos().y() - vr.top() + scrollPos().y() );
+            if ( row >= 0 )
                 setSelectedRow( row );
 
             return;
@@ -282,7 +530,32 @@ void QskListView::mouseReleaseEvent( QMouseEvent* event )
 
 void QskListView::updateScrollableSize()
 {
-    const double h = rowCount() * rowHeight();
+    double h;
+
+    if ( m_data->uniformRowHeights )
+    {
+        h = rowCount() * rowHeight();
+    }
+    else
+    {
+        auto& rowIndex = m_data->rowIndex;
+
+        /*
+            Rebuilding the index is O(n), so we do it only when the number
+            of rows has changed or all heights have been invalidated.
+            Heights of single rows are updated by updateRowHeight.
+         */
+        if ( m_data->rowHeightsDirty || rowIndex.count() != rowCount() )
+        {
+            rowIndex.reset( this );
+            m_data->rowHeightsDirty = false;
+
+            // we don't know which heights have changed
+            m_data->allRowsDirty = true;
+        }
+
+        h = rowIndex.totalHeight();
+    }
 
     qreal w = 0.0;
     for ( int col = 0; col < columnCount(); col++ )
@@ -299,6 +572,95 @@ void QskListView::updateScrollableSize()
     }
 }
 
+void QskListView::invalidateRowHeights()
+{
+    m_data->rowHeightsDirty = true;
+    updateScrollableSize();
+}
+
+void QskListView::updateRowHeight( int row )
+{
+    /*
+        When only the height of a single row has changed we can
+        update the index in O(log n), instead of rebuilding it
+        from scratch in updateScrollableSize
+     */
+
+    if ( m_data->uniformRowHeights )
+        return;
+
+    auto& rowIndex = m_data->rowIndex;
+
+    if ( row < 0 || row >= rowIndex.count() || rowIndex.count() != rowCount() )
+    {
+        updateScrollableSize();
+        return;
+    }
+
+    rowIndex.setHeight( row, rowHeightAt( row ) );
+    m_data->addDirtyRows( row, row );
+
+    auto sz = scrollableSize();
+    sz.setHeight( rowIndex.totalHeight() );
+
+    setScrollableSize( sz );
+    update();
+}
+
+void QskListView::setIncrementalUpdates( bool on )
+{
+    if ( on != m_data->incrementalUpdates )
+    {
+        m_data->incrementalUpdates = on;
+        m_data->allRowsDirty = true;
+        m_data->dirtyRows.clear();
+
+        update();
+    }
+}
+
+bool QskListView::incrementalUpdates() const
+{
+    return m_data->incrementalUpdates;
+}
+
+void QskListView::updateRows( int from, int to )
+{
+    if ( from < 0 )
+        from = 0;
+
+    if ( to < 0 || to >= rowCount() )
+        to = rowCount() - 1;
+
+    if ( from <= to )
+    {
+        m_data->addDirtyRows( from, to );
+        update();
+    }
+}
+
+bool QskListView::isRowDirty( int row ) const
+{
+    if ( !m_data->incrementalUpdates || m_data->allRowsDirty )
+        return true;
+
+    for ( const auto& range : m_data->dirtyRows )
+    {
+        if ( row >= range.first && row <= range.second )
+            return true;
+    }
+
+    return false;
+}
+
+void QskListView::updateNode( QSGNode* node )
+{
+    Inherited::updateNode( node );
+
+    m_data->allRowsDirty = false;
+    m_data->dirtyRows.clear();
+}
+
 void QskListView::componentComplete()
 {
     Inherited::componentComplete();
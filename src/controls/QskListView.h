@@ -28,6 +28,12 @@ class QSK_EXPORT QskListView : public QskScrollView
     Q_PROPERTY( bool preferredWidthFromColumns READ preferredWidthFromColumns
         WRITE setPreferredWidthFromColumns NOTIFY preferredWidthFromColumnsChanged() )
 
+    Q_PROPERTY( bool uniformRowHeights READ uniformRowHeights
+        WRITE setUniformRowHeights NOTIFY uniformRowHeightsChanged FINAL )
+
+    Q_PROPERTY( int prefetchRows READ prefetchRows
+        WRITE setPrefetchRows NOTIFY prefetchRowsChanged FINAL )
+
     using Inherited = QskScrollView;
 
   public:
@@ -64,6 +70,16 @@ class QSK_EXPORT QskListView : public QskScrollView
     void setTextOptions( const QskTextOptions& textOptions );
     QskTextOptions textOptions() const;
 
+    void setUniformRowHeights( bool );
+    bool uniformRowHeights() const;
+
+    /*
+        Number of rows beyond the viewport, that are prepared
+        ahead of the scrolling direction
+     */
+    void setPrefetchRows( int );
+    int prefetchRows() const;
+
     Q_INVOKABLE int selectedRow() const;
 
     virtual int rowCount() const = 0;
@@ -72,6 +88,14 @@ class QSK_EXPORT QskListView : public QskScrollView
     virtual qreal columnWidth( int col ) const = 0;
     virtual qreal rowHeight() const = 0;
 
+    // only called, when uniformRowHeights is disabled
+    virtual qreal rowHeightAt( int row ) const;
+
+    qreal rowOffset( int row ) const;
+    int rowAt( qreal y ) const;
+
+    Q_INVOKABLE void scrollToRow( int row );
+
     Q_INVOKABLE virtual QVariant valueAt( int row, int col ) const = 0;
 
 #if 1
@@ -81,6 +105,9 @@ class QSK_EXPORT QskListView : public QskScrollView
 
     QSizeF contentsSizeHint() const override;
 
+    bool incrementalUpdates() const;
+    bool isRowDirty( int row ) const;
+
   public Q_SLOTS:
     void setSelectedRow( int row );
 
@@ -91,6 +118,8 @@ class QSK_EXPORT QskListView : public QskScrollView
     void alternatingRowColorsChanged();
     void preferredWidthFromColumnsChanged();
     void textOptionsChanged();
+    void uniformRowHeightsChanged();
+    void prefetchRowsChanged();
 
   protected:
     void keyPressEvent( QKeyEvent* ) override;
@@ -101,6 +130,20 @@ class QSK_EXPORT QskListView : public QskScrollView
 
     void updateScrollableSize();
 
+    // for subclasses with variable row heights
+    void invalidateRowHeights();
+    void updateRowHeight( int row );
+
+    /*
+        With incremental updates the skinlet updates only the cells
+        of rows, that have been reported by updateRows. This is an option
+        for subclasses, that are able to report all changes of their data.
+     */
+    void setIncrementalUpdates( bool );
+    void updateRows( int from, int to = -1 );
+
+    void updateNode( QSGNode* ) override;
+
     void componentComplete() override;
 
   private:
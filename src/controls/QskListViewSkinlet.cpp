@@ -9,10 +9,101 @@
 #include "QskColorFilter.h"
 #include "QskGraphic.h"
 
+#include <qatomic.h>
+#include <qglobalstatic.h>
+#include <qhash.h>
 #include <qmath.h>
 #include <qsgnode.h>
 #include <qsgsimplerectnode.h>
 #include <qtransform.h>
+#include <qvector.h>
+
+#ifndef QT_NO_DEBUG_STREAM
+#include <qdebug.h>
+#endif
+
+static inline bool qskHasEnvironment( const char* env )
+{
+    bool ok;
+
+    const int value = qEnvironmentVariableIntValue( env, &ok );
+    if ( ok )
+        return value != 0;
+
+    // All other strings are true, apart from "false"
+    auto result = qgetenv( env );
+    return !result.isEmpty() && result != "false";
+}
+
+static inline bool qskIsStatisticsEnabled()
+{
+    static const bool enabled = qskHasEnvironment( "QSK_LISTVIEW_STATISTICS" );
+    return enabled;
+}
+
+namespace
+{
+    /*
+        The nodes are counted by each list view node on the render thread
+        of its window and the totals are updated once per update of the node.
+        As all of this is only of interest for tuning, nothing is counted
+        unless QSK_LISTVIEW_STATISTICS is set.
+     */
+    class Statistics
+    {
+      public:
+        inline Statistics()
+        {
+            reset();
+        }
+
+#ifndef QT_NO_DEBUG_STREAM
+        void debugStatistics( QDebug debug )
+        {
+            QDebugStateSaver saver( debug );
+            debug.nospace();
+            debug << '(';
+            debug << "frames: " << frames.load()
+                  << ", allocated: " << allocated.load()
+                  << ", recycled: " << recycled.load()
+                  << ", maximum per frame: " << maximumFrame.load();
+            debug << ')';
+        }
+#endif
+
+        inline void reset()
+        {
+            frames.store( 0 );
+            allocated.store( 0 );
+            recycled.store( 0 );
+            maximumFrame.store( 0 );
+        }
+
+        void addFrame( int allocatedNodes, int recycledNodes )
+        {
+            frames.ref();
+            allocated.fetchAndAddRelaxed( allocatedNodes );
+            recycled.fetchAndAddRelaxed( recycledNodes );
+
+            int maximum = maximumFrame.load();
+            while ( allocatedNodes > maximum )
+            {
+                if ( maximumFrame.testAndSetRelaxed(
+                    maximum, allocatedNodes, maximum ) )
+                {
+                    break;
+                }
+            }
+        }
+
+        QAtomicInt frames;
+        QAtomicInt allocated;
+        QAtomicInt recycled;
+        QAtomicInt maximumFrame;
+    };
+}
+
+Q_GLOBAL_STATIC( Statistics, qskStatistics )
 
 class QskListViewNode final : public QSGTransformNode
 {
@@ -21,6 +112,11 @@ class QskListViewNode final : public QSGTransformNode
         : columnCount( columnCount )
         , m_rowMin( -1 )
         , m_rowMax( -1 )
+        , m_scrollY( 0.0 )
+        , m_scrollingDown( true )
+        , m_styleHash( 0 )
+        , m_allocatedNodes( 0 )
+        , m_recycledNodes( 0 )
     {
         m_backgroundNode.setFlag( QSGNode::OwnedByParent, false );
         appendChildNode( &m_backgroundNode );
@@ -29,6 +125,14 @@ class QskListViewNode final : public QSGTransformNode
         appendChildNode( &m_foregroundNode );
     }
 
+    ~QskListViewNode() override
+    {
+        for ( auto& cellNodes : m_recycledCellNodes )
+            qDeleteAll( cellNodes );
+
+        qDeleteAll( m_recycledRowNodes );
+    }
+
     QSGNode* backgroundNode()
     {
         return &m_backgroundNode;
@@ -70,16 +174,214 @@ class QskListViewNode final : public QSGTransformNode
         m_rowMin = m_rowMax = -1;
     }
 
+    inline bool updateScrollDirection( qreal scrollY )
+    {
+        // keeping the previous direction, when not being scrolled
+
+        if ( scrollY != m_scrollY )
+        {
+            m_scrollingDown = scrollY > m_scrollY;
+            m_scrollY = scrollY;
+        }
+
+        return m_scrollingDown;
+    }
+
+    inline bool updateStyleHash( uint hash )
+    {
+        const bool changed = ( hash != m_styleHash ) || ( m_rowMin < 0 );
+        m_styleHash = hash;
+
+        return changed;
+    }
+
+    /*
+        Nodes of cells/rows, that are leaving the viewport are not deleted,
+        but parked in a pool, so that they can be reused for the
+        cells/rows becoming visible - f.e when flicking through a huge list.
+        Cell nodes are kept by the role of their content as reusing
+        a text node for a graphic ( or vice versa ) is pointless.
+     */
+
+    inline void recycleCellNode( QSGTransformNode* node, int role )
+    {
+        if ( node->parent() )
+            node->parent()->removeChildNode( node );
+
+        m_recycledCellNodes[ qBound( 0, role, CellRoleCount - 1 ) ] += node;
+
+        if ( qskIsStatisticsEnabled() )
+            m_recycledNodes++;
+    }
+
+    inline QSGTransformNode* takeCellNode( int role )
+    {
+        auto& cellNodes = m_recycledCellNodes[ qBound( 0, role, CellRoleCount - 1 ) ];
+        if ( cellNodes.isEmpty() )
+            return nullptr;
+
+        return cellNodes.takeLast();
+    }
+
+    inline void recycleRowNode( QSGSimpleRectNode* node )
+    {
+        if ( node->parent() )
+            node->parent()->removeChildNode( node );
+
+        m_recycledRowNodes += node;
+
+        if ( qskIsStatisticsEnabled() )
+            m_recycledNodes++;
+    }
+
+    inline QSGSimpleRectNode* takeRowNode()
+    {
+        if ( m_recycledRowNodes.isEmpty() )
+            return nullptr;
+
+        return m_recycledRowNodes.takeLast();
+    }
+
+    inline void trimRecycledNodes( int maxCount )
+    {
+        // we don't want to keep more spare nodes than visible ones
+
+        for ( auto& cellNodes : m_recycledCellNodes )
+        {
+            while ( cellNodes.size() > maxCount )
+                delete cellNodes.takeLast();
+        }
+
+        while ( m_recycledRowNodes.size() > maxCount )
+            delete m_recycledRowNodes.takeLast();
+    }
+
+    inline void countAllocation()
+    {
+        if ( qskIsStatisticsEnabled() )
+            m_allocatedNodes++;
+    }
+
+    inline void flushStatistics()
+    {
+        if ( qskIsStatisticsEnabled() && qskStatistics )
+        {
+            qskStatistics->addFrame( m_allocatedNodes, m_recycledNodes );
+            m_allocatedNodes = m_recycledNodes = 0;
+        }
+    }
+
+    inline void setColumnRole( int col, int role )
+    {
+        if ( col >= m_columnRoles.size() )
+            m_columnRoles.resize( col + 1 );
+
+        m_columnRoles[ col ] = role;
+    }
+
+    inline int columnRole( int col ) const
+    {
+        return ( col < m_columnRoles.size() ) ? m_columnRoles[ col ] : 0;
+    }
+
     const int columnCount;
 
+    enum { CellRoleCount = 3 };
+
   private:
     int m_rowMin;
     int m_rowMax;
 
+    qreal m_scrollY;
+    bool m_scrollingDown;
+
+    uint m_styleHash;
+
+    int m_allocatedNodes;
+    int m_recycledNodes;
+
+    QVector< QSGTransformNode* > m_recycledCellNodes[ CellRoleCount ];
+    QVector< QSGSimpleRectNode* > m_recycledRowNodes;
+    QVector< int > m_columnRoles;
+
     QSGNode m_backgroundNode;
     QSGNode m_foregroundNode;
 };
 
+static inline qreal qskRowHeight(
+    const QskListView* listView, int row, qreal uniformHeight )
+{
+    return listView->uniformRowHeights() ? uniformHeight : listView->rowHeightAt( row );
+}
+
+static inline void qskVisibleRows(
+    const QskListView* listView, int& rowMin, int& rowMax )
+{
+    const qreal y = listView->scrollPos().y();
+    const qreal height = listView->viewContentsRect().height();
+
+    const int lastRow = listView->rowCount() - 1;
+
+    rowMin = listView->rowAt( y );
+    if ( rowMin < 0 )
+        rowMin = qMax( lastRow, 0 );
+
+    rowMax = listView->rowAt( y + height );
+    if ( rowMax < 0 )
+        rowMax = lastRow;
+}
+
+static uint qskCellStyleHash( const QskListView* listView )
+{
+    /*
+        All hints, that have an effect on each cell. As long as they
+        don't change, we can limit updates to the rows, that have been
+        reported as being dirty.
+     */
+    using namespace QskAspect;
+
+    const auto padding = listView->marginsHint( QskListView::Cell | Padding );
+
+    uint hash = qHash( listView->flagHint( QskListView::Cell | Alignment ) );
+
+    hash = qHash( padding.left(), hash );
+    hash = qHash( padding.top(), hash );
+    hash = qHash( padding.right(), hash );
+    hash = qHash( padding.bottom(), hash );
+
+    for ( const auto subControl : { QskListView::Text, QskListView::TextSelected } )
+    {
+        hash = qHash( listView->color( subControl ).rgba(), hash );
+        hash = qHash( listView->color( subControl | TextColor ).rgba(), hash );
+        hash = qHash( listView->color( subControl | StyleColor ).rgba(), hash );
+        hash = qHash( listView->color( subControl | LinkColor ).rgba(), hash );
+        hash = qHash( listView->flagHint( subControl | Style ), hash );
+        hash = qHash( listView->effectiveFont( subControl ), hash );
+    }
+
+    if ( listView->uniformRowHeights() )
+        hash = qHash( listView->rowHeight(), hash );
+
+    for ( int col = 0; col < listView->columnCount(); col++ )
+        hash = qHash( listView->columnWidth( col ), hash );
+
+    return hash;
+}
+
+static inline QSGSimpleRectNode* qskAppendRowNode(
+    QskListViewNode* listViewNode, QSGNode* parentNode )
+{
+    auto rowNode = listViewNode->takeRowNode();
+    if ( rowNode == nullptr )
+    {
+        rowNode = new QSGSimpleRectNode();
+        listViewNode->countAllocation();
+    }
+
+    parentNode->appendChildNode( rowNode );
+    return rowNode;
+}
+
 QskListViewSkinlet::QskListViewSkinlet( QskSkin* skin )
     : Inherited( skin )
 {
@@ -93,6 +395,16 @@ QSGNode* QskListViewSkinlet::updateContentsNode(
     const auto* listView = static_cast< const QskListView* >( scrollView );
 
     auto* listViewNode = static_cast< QskListViewNode* >( node );
+
+    if ( listViewNode && listViewNode->columnCount != listView->columnCount() )
+    {
+        /*
+            The cell nodes are arranged by columns, so we start from scratch.
+            The obsolete node is deleted by QskScrollViewSkinlet.
+         */
+        listViewNode = nullptr;
+    }
+
     if ( listViewNode == nullptr )
         listViewNode = new QskListViewNode( listView->columnCount() );
 
@@ -103,6 +415,9 @@ QSGNode* QskListViewSkinlet::updateContentsNode(
     updateBackgroundNodes( listView, listViewNode );
     updateForegroundNodes( listView, listViewNode );
 
+    listViewNode->trimRecycledNodes( qMax( listViewNode->nodeCount(), 1 ) );
+    listViewNode->flushStatistics();
+
     return listViewNode;
 }
 
@@ -111,15 +426,13 @@ void QskListViewSkinlet::updateBackgroundNodes(
 {
     QSGNode* backgroundNode = listViewNode->backgroundNode();
 
-    const qreal cellHeight = listView->rowHeight();
+    const qreal rowHeight = listView->rowHeight();
     const QRectF viewRect = listView->viewContentsRect();
 
     const QPointF scrolledPos = listView->scrollPos();
-    const int rowMin = qFloor( scrolledPos.y() / cellHeight );
 
-    int rowMax = qCeil( ( scrolledPos.y() + viewRect.height() ) / cellHeight );
-    if ( rowMax >= listView->rowCount() )
-        rowMax = listView->rowCount() - 1;
+    int rowMin, rowMax;
+    qskVisibleRows( listView, rowMin, rowMax );
 
     const int rowSelected = listView->selectedRow();
     const double x0 = viewRect.left() + scrolledPos.x();
@@ -142,12 +455,10 @@ void QskListViewSkinlet::updateBackgroundNodes(
             if ( row % 2 )
             {
                 if ( rowNode == nullptr )
-                {
-                    rowNode = new QSGSimpleRectNode();
-                    backgroundNode->appendChildNode( rowNode );
-                }
+                    rowNode = qskAppendRowNode( listViewNode, backgroundNode );
 
-                rowNode->setRect( x0, y0 + row * cellHeight, viewRect.width(), cellHeight );
+                rowNode->setRect( x0, y0 + listView->rowOffset( row ),
+                    viewRect.width(), qskRowHeight( listView, row, rowHeight ) );
                 rowNode->setColor( color );
 
                 rowNode = static_cast< QSGSimpleRectNode* >( rowNode->nextSibling() );
@@ -160,23 +471,21 @@ void QskListViewSkinlet::updateBackgroundNodes(
         const QColor color = listView->color( QskListView::CellSelected );
 
         if ( rowNode == nullptr )
-        {
-            rowNode = new QSGSimpleRectNode();
-            backgroundNode->appendChildNode( rowNode );
-        }
+            rowNode = qskAppendRowNode( listViewNode, backgroundNode );
 
-        rowNode->setRect( x0, y0 + rowSelected * cellHeight, viewRect.width(), cellHeight );
+        rowNode->setRect( x0, y0 + listView->rowOffset( rowSelected ),
+            viewRect.width(), qskRowHeight( listView, rowSelected, rowHeight ) );
         rowNode->setColor( color );
 
         rowNode = static_cast< QSGSimpleRectNode* >( rowNode->nextSibling() );
     }
 
-    QSGNode* nextNode = rowNode;
-    while ( nextNode != nullptr )
+    while ( rowNode != nullptr )
     {
-        QSGNode* tmpNode = nextNode;
-        nextNode = nextNode->nextSibling();
-        delete tmpNode;
+        auto tmpNode = rowNode;
+        rowNode = static_cast< QSGSimpleRectNode* >( rowNode->nextSibling() );
+
+        listViewNode->recycleRowNode( tmpNode );
     }
 }
 
@@ -187,7 +496,12 @@ void QskListViewSkinlet::updateForegroundNodes(
 
     if ( listView->rowCount() <= 0 || listView->columnCount() <= 0 )
     {
-        parentNode->removeAllChildNodes();
+        while ( auto childNode = parentNode->firstChild() )
+        {
+            auto cellNode = static_cast< QSGTransformNode* >( childNode );
+            listViewNode->recycleCellNode( cellNode, cellRole( cellNode ) );
+        }
+
         listViewNode->invalidate();
         return;
     }
@@ -197,11 +511,22 @@ void QskListViewSkinlet::updateForegroundNodes(
     const QRectF cr = listView->viewContentsRect();
     const QPointF scrolledPos = listView->scrollPos();
 
-    const int rowMin = qFloor( scrolledPos.y() / listView->rowHeight() );
+    int rowMin, rowMax;
+    qskVisibleRows( listView, rowMin, rowMax );
+
+    /*
+        Preparing the nodes of a couple of rows ahead of the scrolling
+        direction, so that they are ready when being flicked into the viewport
+     */
+    const bool scrollingDown = listViewNode->updateScrollDirection( scrolledPos.y() );
 
-    int rowMax = rowMin + qCeil( cr.height() / listView->rowHeight() );
-    if ( rowMax >= listView->rowCount() )
-        rowMax = listView->rowCount() - 1;
+    if ( const int prefetchRows = listView->prefetchRows() )
+    {
+        if ( scrollingDown )
+            rowMax = qMin( rowMax + prefetchRows, listView->rowCount() - 1 );
+        else
+            rowMin = qMax( rowMin - prefetchRows, 0 );
+    }
 
 #if 1
     // should be optimized for visible columns only
@@ -211,6 +536,10 @@ void QskListViewSkinlet::updateForegroundNodes(
 
     bool forwards = true;
 
+    // rows, that had been visible before and don't need to be updated
+    int validMin = 0;
+    int validMax = -1;
+
     if ( listViewNode->intersects( rowMin, rowMax ) )
     {
         /*
@@ -220,6 +549,17 @@ void QskListViewSkinlet::updateForegroundNodes(
 
         forwards = ( rowMin >= listViewNode->rowMin() );
 
+        if ( forwards )
+        {
+            validMin = rowMin;
+            validMax = qMin( rowMax, listViewNode->rowMax() );
+        }
+        else if ( rowMax <= listViewNode->rowMax() )
+        {
+            validMin = listViewNode->rowMin();
+            validMax = rowMax;
+        }
+
         if ( forwards )
         {
             // usually scrolling down
@@ -248,14 +588,21 @@ void QskListViewSkinlet::updateForegroundNodes(
         }
     }
 
+    if ( !listView->incrementalUpdates()
+        || listViewNode->updateStyleHash( qskCellStyleHash( listView ) ) )
+    {
+        validMin = 0;
+        validMax = -1;
+    }
+
     updateVisibleForegroundNodes( listView, listViewNode,
-        rowMin, rowMax, colMin, colMax, margins, forwards );
+        rowMin, rowMax, colMin, colMax, validMin, validMax, margins, forwards );
 
     // finally putting the nodes into their position
     auto node = parentNode->firstChild();
 
     const qreal rowHeight = listView->rowHeight();
-    qreal y = cr.top() + rowMin * rowHeight;
+    qreal y = cr.top() + listView->rowOffset( rowMin );
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
@@ -275,7 +622,7 @@ void QskListViewSkinlet::updateForegroundNodes(
             x += listView->columnWidth( col );
         }
 
-        y += rowHeight;
+        y += qskRowHeight( listView, row, rowHeight );
     }
 
     listViewNode->resetRows( rowMin, rowMax );
@@ -283,8 +630,8 @@ void QskListViewSkinlet::updateForegroundNodes(
 
 void QskListViewSkinlet::updateVisibleForegroundNodes(
     const QskListView* listView, QskListViewNode* listViewNode,
-    int rowMin, int rowMax, int colMin, int colMax, const QMarginsF& margins,
-    bool forward ) const
+    int rowMin, int rowMax, int colMin, int colMax,
+    int validMin, int validMax, const QMarginsF& margins, bool forward ) const
 {
     QSGNode* parentNode = listViewNode->foregroundNode();
 
@@ -292,23 +639,38 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
     const int colCount = colMax - colMin + 1;
     const int obsoleteNodesCount = listViewNode->nodeCount() - rowCount * colCount;
 
+    const qreal rowHeight = listView->rowHeight();
+
     if ( forward )
     {
         for ( int i = 0; i < obsoleteNodesCount; i++ )
-            delete parentNode->lastChild();
+        {
+            auto cellNode = static_cast< QSGTransformNode* >( parentNode->lastChild() );
+            listViewNode->recycleCellNode( cellNode, cellRole( cellNode ) );
+        }
 
         auto node = parentNode->firstChild();
 
         for ( int row = rowMin; row <= rowMax; row++ )
         {
-            const qreal h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+            if ( node && row >= validMin && row <= validMax
+                && !listView->isRowDirty( row ) )
+            {
+                for ( int col = 0; col < listView->columnCount(); col++ )
+                    node = node->nextSibling();
+
+                continue;
+            }
+
+            const qreal h = qskRowHeight( listView, row, rowHeight )
+                - ( margins.top() + margins.bottom() );
 
             for ( int col = 0; col < listView->columnCount(); col++ )
             {
                 const qreal w = listView->columnWidth( col ) - ( margins.left() + margins.right() );
 
                 node = updateForegroundNode( listView,
-                    parentNode, static_cast< QSGTransformNode* >( node ),
+                    listViewNode, static_cast< QSGTransformNode* >( node ),
                     row, col, QSizeF( w, h ), forward );
 
                 node = node->nextSibling();
@@ -318,20 +680,33 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
     else
     {
         for ( int i = 0; i < obsoleteNodesCount; i++ )
-            delete parentNode->firstChild();
+        {
+            auto cellNode = static_cast< QSGTransformNode* >( parentNode->firstChild() );
+            listViewNode->recycleCellNode( cellNode, cellRole( cellNode ) );
+        }
 
         auto* node = parentNode->lastChild();
 
         for ( int row = rowMax; row >= rowMin; row-- )
         {
-            const qreal h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+            if ( node && row >= validMin && row <= validMax
+                && !listView->isRowDirty( row ) )
+            {
+                for ( int col = 0; col < listView->columnCount(); col++ )
+                    node = node->previousSibling();
+
+                continue;
+            }
+
+            const qreal h = qskRowHeight( listView, row, rowHeight )
+                - ( margins.top() + margins.bottom() );
 
             for ( int col = listView->columnCount() - 1; col >= 0; col-- )
             {
                 const qreal w = listView->columnWidth( col ) - ( margins.left() + margins.right() );
 
                 node = updateForegroundNode( listView,
-                    parentNode, static_cast< QSGTransformNode* >( node ),
+                    listViewNode, static_cast< QSGTransformNode* >( node ),
                     row, col, QSizeF( w, h ), forward );
 
                 node = node->previousSibling();
@@ -341,89 +716,100 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
 }
 
 QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
-    const QskListView* listView, QSGNode* parentNode, QSGTransformNode* cellNode,
-    int row, int col, const QSizeF& size, bool forward ) const
+    const QskListView* listView, QskListViewNode* listViewNode,
+    QSGTransformNode* cellNode, int row, int col,
+    const QSizeF& size, bool forward ) const
 {
+    QSGNode* parentNode = listViewNode->foregroundNode();
+
     const QRectF cellRect( 0.0, 0.0, size.width(), size.height() );
 
+    if ( cellNode == nullptr )
+    {
+        // most likely a cell of the same column has the same type of content
+        cellNode = listViewNode->takeCellNode( listViewNode->columnRole( col ) );
+    }
+
     /*
         Text nodes already have a transform root node - to avoid inserting extra
         transform nodes, the code below becomes a bit more complicated.
      */
+
+    const bool isTextCell = cellNode && ( nodeRole( cellNode ) == TextRole );
+
+    QSGNode* oldNode = nullptr;
+    if ( cellNode )
+        oldNode = isTextCell ? cellNode : cellNode->firstChild();
+
+    auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
+    if ( newNode && newNode != oldNode )
+        listViewNode->countAllocation();
+
     QSGTransformNode* newCellNode = nullptr;
 
-    if ( cellNode && ( cellNode->type() == QSGNode::TransformNodeType ) )
+    if ( newNode && newNode->type() == QSGNode::TransformNodeType )
     {
-        QSGNode* oldNode = cellNode;
+        newCellNode = static_cast< QSGTransformNode* >( newNode );
+    }
+    else if ( cellNode && !isTextCell )
+    {
+        // reusing the wrapping transform node
 
-        auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
-        if ( newNode )
+        if ( newNode != oldNode )
         {
-            if ( newNode->type() == QSGNode::TransformNodeType )
-            {
-                newCellNode = static_cast< QSGTransformNode* >( newNode );
-            }
-            else
-            {
-                newCellNode = new QSGTransformNode();
-                newCellNode->appendChildNode( newNode );
-            }
+            delete oldNode;
+
+            if ( newNode )
+                cellNode->appendChildNode( newNode );
         }
+
+        newCellNode = cellNode;
     }
     else
     {
-        QSGNode* oldNode = cellNode ? cellNode->firstChild() : nullptr;
-        auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
+        newCellNode = new QSGTransformNode();
+        listViewNode->countAllocation();
 
         if ( newNode )
-        {
-            if ( newNode->type() == QSGNode::TransformNodeType )
-            {
-                newCellNode = static_cast< QSGTransformNode* >( newNode );
-            }
-            else
-            {
-                if ( cellNode == nullptr )
-                {
-                    newCellNode = new QSGTransformNode();
-                    newCellNode->appendChildNode( newNode );
-                }
-                else
-                {
-                    if ( newNode != oldNode )
-                    {
-                        delete cellNode->firstChild();
-                        cellNode->appendChildNode( newNode );
-
-                        newCellNode = cellNode;
-                    }
-                }
-            }
-        }
+            newCellNode->appendChildNode( newNode );
     }
 
-    if ( newCellNode == nullptr )
-        newCellNode = new QSGTransformNode();
-
     if ( cellNode != newCellNode )
     {
-        if ( cellNode )
-        {
+        if ( cellNode && cellNode->parent() == parentNode )
             parentNode->insertChildNodeAfter( newCellNode, cellNode );
-            delete cellNode;
-        }
+
+        if ( cellNode )
+            listViewNode->recycleCellNode( cellNode, cellRole( cellNode ) );
+    }
+
+    if ( newCellNode->parent() != parentNode )
+    {
+        if ( forward )
+            parentNode->appendChildNode( newCellNode );
         else
-        {
-            if ( forward )
-                parentNode->appendChildNode( newCellNode );
-            else
-                parentNode->prependChildNode( newCellNode );
-        }
+            parentNode->prependChildNode( newCellNode );
     }
 
+    listViewNode->setColumnRole( col, cellRole( newCellNode ) );
+
     return newCellNode;
 }
 
+int QskListViewSkinlet::cellRole( const QSGTransformNode* cellNode )
+{
+    if ( nodeRole( cellNode ) == TextRole )
+        return TextRole;
+
+    if ( auto childNode = cellNode->firstChild() )
+    {
+        if ( nodeRole( childNode ) == GraphicRole )
+            return GraphicRole;
+    }
+
+    return GraphicRole + 1;
+}
+
 QSGNode* QskListViewSkinlet::updateCellNode( const QskListView* listView,
     QSGNode* contentNode, const QRectF& rect, int row, int col ) const
 {
@@ -475,4 +861,14 @@ QSGNode* QskListViewSkinlet::updateCellNode( const QskListView* listView,
     return newNode;
 }
 
+#ifndef QT_NO_DEBUG_STREAM
+
+void QskListViewSkinlet::debugStatistics( QDebug debug )
+{
+    if ( qskStatistics )
+        qskStatistics->debugStatistics( debug );
+}
+
+#endif
+
 #include "moc_QskListViewSkinlet.cpp"
@@ -8,6 +8,7 @@
 
 #include "QskScrollViewSkinlet.h"
 
+class QDebug;
 class QskListView;
 class QskListViewNode;
 class QskTextNode;
@@ -22,6 +23,11 @@ class QSK_EXPORT QskListViewSkinlet : public QskScrollViewSkinlet
     Q_INVOKABLE QskListViewSkinlet( QskSkin* = nullptr );
     ~QskListViewSkinlet() override;
 
+#ifndef QT_NO_DEBUG_STREAM
+    // allocations/recycling of cell nodes, counted when QSK_LISTVIEW_STATISTICS is set
+    static void debugStatistics( QDebug );
+#endif
+
   protected:
     enum NodeRole
     {
@@ -42,11 +48,13 @@ class QSK_EXPORT QskListViewSkinlet : public QskScrollViewSkinlet
     void updateVisibleForegroundNodes(
         const QskListView*, QskListViewNode*,
         int rowMin, int rowMax, int colMin, int colMax,
-        const QMarginsF& margin, bool forward ) const;
+        int validMin, int validMax, const QMarginsF& margin, bool forward ) const;
 
     QSGTransformNode* updateForegroundNode( const QskListView*,
-        QSGNode* parentNode, QSGTransformNode* cellNode,
+        QskListViewNode*, QSGTransformNode* cellNode,
         int row, int col, const QSizeF&, bool forward ) const;
+
+    static int cellRole( const QSGTransformNode* );
 };
 
 #endif
@@ -0,0 +1,248 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskModelListView.h"
+#include "QskAspect.h"
+
+#include <qfontmetrics.h>
+#include <qpointer.h>
+#include <qvector.h>
+
+class QskModelListView::PrivateData
+{
+  public:
+    QPointer< QAbstractItemModel > model;
+    QVector< QMetaObject::Connection > connections;
+
+    QVector< qreal > columnWidths;
+};
+
+QskModelListView::QskModelListView( QQuickItem* parent )
+    : Inherited( parent )
+    , m_data( new PrivateData() )
+{
+    setIncrementalUpdates( true );
+}
+
+QskModelListView::~QskModelListView()
+{
+}
+
+void QskModelListView::setModel( QAbstractItemModel* model )
+{
+    if ( model == m_data->model )
+        return;
+
+    for ( const auto& connection : m_data->connections )
+        disconnect( connection );
+
+    m_data->connections.clear();
+    m_data->model = model;
+
+    if ( model )
+    {
+        using M = QAbstractItemModel;
+
+        auto& c = m_data->connections;
+
+        /*
+            Changes are not processed immediately. The affected rows
+            are collected and the cells are updated, when the next
+            frame is rendered.
+         */
+
+        c += connect( model, &M::dataChanged, this,
+            [ this ]( const QModelIndex& topLeft, const QModelIndex& bottomRight )
+            {
+                if ( !topLeft.parent().isValid() )
+                    updateModelRows( topLeft.row(), bottomRight.row(), false );
+            } );
+
+        c += connect( model, &M::rowsInserted, this,
+            [ this ]( const QModelIndex& parent, int first, int last )
+            {
+                if ( !parent.isValid() )
+                    insertModelRows( first, last );
+            } );
+
+        c += connect( model, &M::rowsRemoved, this,
+            [ this ]( const QModelIndex& parent, int first, int last )
+            {
+                if ( !parent.isValid() )
+                    removeModelRows( first, last );
+            } );
+
+        c += connect( model, &M::rowsMoved, this,
+            [ this ]( const QModelIndex& sourceParent, int first, int last,
+                const QModelIndex& destinationParent, int row )
+            {
+                // only the top level rows are displayed
+
+                const bool fromTopLevel = !sourceParent.isValid();
+                const bool toTopLevel = !destinationParent.isValid();
+
+                if ( fromTopLevel && toTopLevel )
+                    moveModelRows( first, last, row );
+                else if ( fromTopLevel )
+                    removeModelRows( first, last );
+                else if ( toTopLevel )
+                    insertModelRows( row, row + last - first );
+            } );
+
+        c += connect( model, &M::columnsInserted, this, &QskModelListView::resetModel );
+        c += connect( model, &M::columnsRemoved, this, &QskModelListView::resetModel );
+        c += connect( model, &M::modelReset, this, &QskModelListView::resetModel );
+        c += connect( model, &M::layoutChanged, this, &QskModelListView::resetModel );
+        c += connect( model, &QObject::destroyed, this, &QskModelListView::resetModel );
+    }
+
+    resetModel();
+
+    Q_EMIT modelChanged();
+}
+
+QAbstractItemModel* QskModelListView::model() const
+{
+    return m_data->model;
+}
+
+void QskModelListView::setColumnWidth( int col, qreal width )
+{
+    if ( col < 0 )
+        return;
+
+    if ( col >= m_data->columnWidths.size() )
+        m_data->columnWidths.resize( col + 1 );
+
+    m_data->columnWidths[ col ] = qMax( width, qreal( 0.0 ) );
+    updateScrollableSize();
+}
+
+int QskModelListView::rowCount() const
+{
+    return m_data->model ? m_data->model->rowCount() : 0;
+}
+
+int QskModelListView::columnCount() const
+{
+    return m_data->model ? m_data->model->columnCount() : 0;
+}
+
+qreal QskModelListView::columnWidth( int col ) const
+{
+    if ( col < 0 || col >= columnCount() )
+        return 0.0;
+
+    if ( col < m_data->columnWidths.size() && m_data->columnWidths[ col ] > 0.0 )
+        return m_data->columnWidths[ col ];
+
+    const auto sizeHint = m_data->model->headerData(
+        col, Qt::Horizontal, Qt::SizeHintRole );
+
+    if ( sizeHint.canConvert< QSizeF >() )
+    {
+        const qreal w = sizeHint.toSizeF().width();
+        if ( w > 0.0 )
+            return w;
+    }
+
+    // no idea what to do
+    const QFontMetricsF fm( effectiveFont( Text ) );
+    return 20 * fm.averageCharWidth();
+}
+
+qreal QskModelListView::rowHeight() const
+{
+    const QMarginsF padding = marginsHint( Cell | QskAspect::Padding );
+    const QFontMetricsF fm( effectiveFont( Text ) );
+
+    return fm.height() + padding.top() + padding.bottom();
+}
+
+QVariant QskModelListView::valueAt( int row, int col ) const
+{
+    const auto model = m_data->model.data();
+    if ( model == nullptr )
+        return QVariant();
+
+    return model->data( model->index( row, col ), Qt::DisplayRole );
+}
+
+void QskModelListView::resetModel()
+{
+    const int count = rowCount();
+
+    if ( selectedRow() >= count )
+        setSelectedRow( count - 1 );
+
+    updateScrollableSize();
+    updateRows( 0, -1 );
+}
+
+void QskModelListView::insertModelRows( int first, int last )
+{
+    // the selection stays with its entry
+
+    const int row = selectedRow();
+    if ( row >= first )
+        setSelectedRow( row + last - first + 1 );
+
+    updateModelRows( first, -1, true );
+}
+
+void QskModelListView::removeModelRows( int first, int last )
+{
+    const int row = selectedRow();
+
+    if ( row > last )
+        setSelectedRow( row - ( last - first + 1 ) );
+    else if ( row >= first )
+        setSelectedRow( -1 );
+
+    updateModelRows( first, -1, true );
+}
+
+void QskModelListView::moveModelRows( int first, int last, int to )
+{
+    /*
+        "to" is the position before the move, so when
+        moving rows down it is behind the moved rows
+     */
+    const int count = last - first + 1;
+    const int row = selectedRow();
+
+    if ( row >= first && row <= last )
+    {
+        const int offset = ( to > last ) ? to - count - first : to - first;
+        setSelectedRow( row + offset );
+    }
+    else if ( to > last && row > last && row < to )
+    {
+        setSelectedRow( row - count );
+    }
+    else if ( to < first && row >= to && row < first )
+    {
+        setSelectedRow( row + count );
+    }
+
+    updateModelRows( qMin( first, to ), qMax( last, to ), false );
+}
+
+void QskModelListView::updateModelRows( int from, int to, bool resized )
+{
+    if ( resized )
+    {
+        const int count = rowCount();
+
+        if ( selectedRow() >= count )
+            setSelectedRow( count - 1 );
+
+        updateScrollableSize();
+    }
+
+    updateRows( from, to );
+}
+
+#include "moc_QskModelListView.cpp"
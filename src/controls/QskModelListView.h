@@ -0,0 +1,59 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_MODEL_LIST_VIEW_H
+#define QSK_MODEL_LIST_VIEW_H
+
+#include "QskListView.h"
+#include <qabstractitemmodel.h>
+
+/*
+    A list view displaying the Qt::DisplayRole of the top level rows
+    of a QAbstractItemModel. Changes of the model are collected and
+    only the cells of the affected rows are updated in the next frame.
+ */
+class QSK_EXPORT QskModelListView : public QskListView
+{
+    Q_OBJECT
+
+    Q_PROPERTY( QAbstractItemModel* model READ model
+        WRITE setModel NOTIFY modelChanged FINAL )
+
+    using Inherited = QskListView;
+
+  public:
+    QskModelListView( QQuickItem* parent = nullptr );
+    ~QskModelListView() override;
+
+    void setModel( QAbstractItemModel* );
+    QAbstractItemModel* model() const;
+
+    void setColumnWidth( int col, qreal width );
+
+    int rowCount() const override;
+    int columnCount() const override;
+
+    qreal columnWidth( int col ) const override;
+    qreal rowHeight() const override;
+
+    QVariant valueAt( int row, int col ) const override;
+
+  Q_SIGNALS:
+    void modelChanged();
+
+  private:
+    void resetModel();
+
+    void insertModelRows( int first, int last );
+    void removeModelRows( int first, int last );
+    void moveModelRows( int first, int last, int to );
+
+    void updateModelRows( int from, int to, bool resized );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
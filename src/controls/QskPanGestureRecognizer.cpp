@@ -74,6 +74,12 @@ static void qskSendPanGestureEvent(
 
 namespace
 {
+    /*
+        The velocity is calculated from the first and the last position
+        of a sliding window of events. Individual events are often delivered
+        irregularly, so calculating velocities between neighbours would
+        result in spikes.
+     */
     class VelocityTracker
     {
       public:
@@ -82,57 +88,101 @@ namespace
             reset();
         }
 
-        void record( int elapsed, qreal velocity )
+        void record( ulong timestamp, const QPointF& pos )
         {
-            if ( ( velocity != 0.0 ) && ( m_values[ m_pos ].velocity != 0.0 ) )
+            if ( m_count > 1 )
             {
-                if ( ( velocity > 0.0 ) != ( m_values[ m_pos ].velocity > 0.0 ) )
-                    reset(); // direction has changed
-            }
+                const auto& first = sample( m_count - 1 );
+                const auto& last = sample( 0 );
 
-            m_values[ m_pos ].elapsed = elapsed;
-            m_values[ m_pos ].velocity = velocity;
+                const QPointF d1 = last.pos - first.pos;
+                const QPointF d2 = pos - last.pos;
 
-            m_pos = ( m_pos + 1 ) % Count;
+                if ( QPointF::dotProduct( d1, d2 ) < 0.0 )
+                {
+                    // direction has changed: starting from the turning point
+                    const auto turningPoint = last;
+
+                    reset();
+                    append( turningPoint.timestamp, turningPoint.pos );
+                }
+            }
+
+            append( timestamp, pos );
         }
 
         inline void reset()
         {
-            for ( auto& v : m_values )
-            {
-                v.elapsed = -1;
-                v.velocity = 0;
-            }
             m_pos = 0;
+            m_count = 0;
         }
 
-        inline qreal velocity( ulong elapsed ) const
+        qreal velocity( ulong timestamp,
+            Qt::Orientations orientations, qreal& angle ) const
         {
-            qreal sum = 0;
-            int numVelocities = 0;
+            if ( m_count < 2 )
+                return 0.0;
 
-            for ( const auto& v : m_values )
+            const auto& last = sample( 0 );
+
+            // only events within the window will be considered
+            if ( timestamp > last.timestamp && timestamp - last.timestamp > Window )
+                return 0.0;
+
+            int index = 1;
+            while ( index < m_count - 1
+                && ( last.timestamp - sample( index ).timestamp ) < Window )
             {
-                // only swipe events within the last 500 ms will be considered
-                if ( v.elapsed > 0 && ( elapsed - v.elapsed ) <= 500 )
-                {
-                    sum += v.velocity;
-                    numVelocities++;
-                }
+                index++;
             }
 
-            return ( numVelocities > 0 ) ? ( sum / numVelocities ) : 0.0;
+            const auto& first = sample( index );
+
+            /*
+                When the movement has been paused before the release
+                the velocity has to go down
+             */
+            const ulong elapsed = qMax( timestamp, last.timestamp ) - first.timestamp;
+            if ( elapsed == 0 )
+                return 0.0;
+
+            angle = qskAngle( first.pos, last.pos, orientations );
+
+            const qreal dist = qskDistance( first.pos, last.pos, orientations );
+            return qAbs( dist ) / ( elapsed / 1000.0 );
         }
 
       private:
-        int m_pos;
-        enum { Count = 3 };
+        enum
+        {
+            Count = 16, // capacity of the ring buffer
+            Window = 100 // ms
+        };
+
+        struct Sample
+        {
+            ulong timestamp;
+            QPointF pos;
+        };
+
+        inline void append( ulong timestamp, const QPointF& pos )
+        {
+            m_samples[ m_pos ] = { timestamp, pos };
+
+            m_pos = ( m_pos + 1 ) % Count;
+            m_count = qMin( m_count + 1, int( Count ) );
+        }
 
-        struct
+        // 0: the most recent sample
+        inline const Sample& sample( int index ) const
         {
-            int elapsed;
-            qreal velocity;
-        } m_values[ Count ];
+            return m_samples[ ( m_pos - 1 - index + 2 * Count ) % Count ];
+        }
+
+        Sample m_samples[ Count ];
+
+        int m_pos;
+        int m_count;
     };
 }
 
@@ -195,25 +245,17 @@ void QskPanGestureRecognizer::pressEvent( const QMouseEvent* event )
     m_data->timestamp = timestamp();
 
     m_data->velocityTracker.reset();
+    m_data->velocityTracker.record( m_data->timestamp, m_data->pos );
 }
 
 void QskPanGestureRecognizer::moveEvent( const QMouseEvent* event )
 {
-    const ulong elapsed = event->timestamp() - m_data->timestamp;
-    const ulong elapsedTotal = event->timestamp() - timestamp();
-
     const QPointF oldPos = m_data->pos;
 
     m_data->timestamp = event->timestamp();
     m_data->pos = event->localPos();
 
-    if ( elapsedTotal > 0 ) // ???
-    {
-        const qreal dist = qskDistance( oldPos, m_data->pos, m_data->orientations );
-
-        const qreal velocity = dist / ( elapsed / 1000.0 );
-        m_data->velocityTracker.record( elapsedTotal, velocity );
-    }
+    m_data->velocityTracker.record( m_data->timestamp, m_data->pos );
 
     bool started = false;
 
@@ -234,7 +276,8 @@ void QskPanGestureRecognizer::moveEvent( const QMouseEvent* event )
 
     if ( state() == QskGestureRecognizer::Accepted )
     {
-        const qreal velocity = m_data->velocityTracker.velocity( elapsedTotal );
+        const qreal velocity = m_data->velocityTracker.velocity(
+            m_data->timestamp, m_data->orientations, m_data->angle );
 
         if ( started )
         {
@@ -253,8 +296,8 @@ void QskPanGestureRecognizer::releaseEvent( const QMouseEvent* event )
 {
     if ( state() == QskGestureRecognizer::Accepted )
     {
-        const ulong elapsedTotal = event->timestamp() - timestamp();
-        const qreal velocity = m_data->velocityTracker.velocity( elapsedTotal );
+        const qreal velocity = m_data->velocityTracker.velocity(
+            event->timestamp(), m_data->orientations, m_data->angle );
 
         qskSendPanGestureEvent( watchedItem(), QskGesture::Finished,
             velocity, m_data->angle, m_data->origin, m_data->pos, m_data->pos );
@@ -4,9 +4,11 @@
  *****************************************************************************/
 
 #include "QskPopup.h"
+#include "QskAnimationHint.h"
 #include "QskAspect.h"
 #include "QskInputGrabber.h"
 #include "QskQuick.h"
+#include "QskRenderAnimator.h"
 #include "QskWindow.h"
 #include "QskEvent.h"
 
@@ -107,7 +109,8 @@ class QskPopup::PrivateData
 {
   public:
     PrivateData()
-        : flags( 0 )
+        : fader( nullptr )
+        , flags( 0 )
         , isModal( false )
         , hasFaderEffect( true )
         , autoGrabFocus( true )
@@ -120,6 +123,8 @@ class QskPopup::PrivateData
     uint priority = 0;
     QskAspect::Aspect faderAspect;
 
+    QskRenderAnimator* fader;
+
     int flags           : 4;
     bool isModal        : 1;
     bool hasFaderEffect : 1;
@@ -187,22 +192,105 @@ void QskPopup::setOpen( bool on )
     else
         Q_EMIT closed();
 
-    if ( isFading() )
+    if ( testPopupFlag( QskPopup::RenderThreadFading ) )
+    {
+        const bool wasFading = isFading();
+
+        if ( startFading( on ) )
+        {
+            if ( !wasFading )
+                Q_EMIT fadingChanged( true );
+
+            return;
+        }
+
+        if ( wasFading )
+        {
+            finishFading();
+            return;
+        }
+    }
+    else if ( isFading() )
     {
         Q_EMIT fadingChanged( true );
+        return;
     }
-    else
+
+    if ( !on )
     {
-        if ( !on )
-        {
-            Inherited::setVisible( false );
+        Inherited::setVisible( false );
 
-            if ( testPopupFlag( QskPopup::DeleteOnClose ) )
-                deleteLater();
-        }
+        if ( testPopupFlag( QskPopup::DeleteOnClose ) )
+            deleteLater();
     }
 }
 
+bool QskPopup::startFading( bool open )
+{
+    /*
+        With RenderThreadFading the popup fades its opacity with the
+        animation hint of the fader aspect. Only the opacity is animated,
+        so the fader can run on the scene graph thread and does not
+        stutter, when the GUI thread is busy.
+     */
+
+    const auto aspect = m_data->faderAspect;
+
+    if ( !( m_data->hasFaderEffect && aspect.value() != 0 ) )
+        return false;
+
+    if ( window() == nullptr || !isVisible() )
+        return false;
+
+    const auto hint = effectiveAnimation(
+        aspect.type(), aspect.subControl(), skinState() );
+
+    if ( hint.duration <= 0 )
+        return false;
+
+    auto fader = m_data->fader;
+    if ( fader == nullptr )
+    {
+        fader = new QskRenderAnimator( this, QskRenderAnimator::Opacity, this );
+
+        connect( fader, &QskRenderAnimator::finished,
+            this, &QskPopup::finishFading );
+
+        m_data->fader = fader;
+    }
+
+    // continuing from the current opacity, when reverting a fade
+    const bool isRunning = fader->isRunning();
+    fader->stop();
+
+    fader->setFrom( isRunning ? opacity() : ( open ? 0.0 : 1.0 ) );
+    fader->setTo( open ? 1.0 : 0.0 );
+    fader->setDuration( int( hint.duration ) );
+    fader->setEasingCurve( hint.type );
+
+    fader->start();
+
+    return true;
+}
+
+void QskPopup::finishFading()
+{
+    if ( m_data->fader )
+        m_data->fader->stop();
+
+    if ( !isOpen() )
+    {
+        Inherited::setVisible( false );
+
+        if ( testPopupFlag( QskPopup::DeleteOnClose ) )
+            deleteLater();
+    }
+
+    setOpacity( 1.0 );
+
+    Q_EMIT fadingChanged( false );
+}
+
 bool QskPopup::isOpen() const
 {
     return !( skinState() & QskPopup::Closed );
@@ -210,6 +298,9 @@ bool QskPopup::isOpen() const
 
 bool QskPopup::isFading() const
 {
+    if ( m_data->fader && m_data->fader->isRunning() )
+        return true;
+
     if ( m_data->faderAspect.value() == 0 )
         return false;
 
@@ -304,7 +395,10 @@ bool QskPopup::isTransitionAccepted( QskAspect::Aspect aspect ) const
         }
 
         if ( aspect == m_data->faderAspect )
-            return true;
+        {
+            // with RenderThreadFading the fader runs on its own: see startFading
+            return !testPopupFlag( QskPopup::RenderThreadFading );
+        }
 
         if ( aspect.type() == QskAspect::Color )
         {
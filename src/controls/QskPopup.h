@@ -27,10 +27,16 @@ class QSK_EXPORT QskPopup : public QskControl
     QSK_SUBCONTROLS( Overlay )
     QSK_STATES( Closed )
 
+    /*
+        RenderThreadFading fades the opacity of the popup - with the
+        animation hint of the fader aspect - on the scene graph thread,
+        instead of interpolating the skin hint of the fader aspect.
+     */
     enum PopupFlag
     {
         DeleteOnClose       = 1 << 0,
-        CloseOnPressOutside = 1 << 1
+        CloseOnPressOutside = 1 << 1,
+        RenderThreadFading  = 1 << 2
     };
 
     Q_ENUM( PopupFlag )
@@ -105,6 +111,9 @@ class QSK_EXPORT QskPopup : public QskControl
 
     void updateInputGrabber();
 
+    bool startFading( bool open );
+    void finishFading();
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
@@ -0,0 +1,304 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskRenderAnimator.h"
+#include "QskAnimator.h"
+
+#include <qpointer.h>
+#include <qquickitem.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qquickanimator_p.h>
+#include <private/qsgrenderloop_p.h>
+QSK_QT_PRIVATE_END
+
+static QQuickAnimator* qskCreateQuickAnimator( QskRenderAnimator::Property property )
+{
+    switch ( property )
+    {
+        case QskRenderAnimator::Opacity:
+            return new QQuickOpacityAnimator();
+
+        case QskRenderAnimator::X:
+            return new QQuickXAnimator();
+
+        case QskRenderAnimator::Y:
+            return new QQuickYAnimator();
+
+        case QskRenderAnimator::Scale:
+            return new QQuickScaleAnimator();
+
+        case QskRenderAnimator::Rotation:
+            return new QQuickRotationAnimator();
+    }
+
+    return nullptr;
+}
+
+// advancing by the QskAnimator driver on the GUI thread
+class QskRenderAnimatorFallback final : public QskAnimator
+{
+  public:
+    QskRenderAnimatorFallback( QskRenderAnimator* animator )
+        : m_animator( animator )
+        , m_isCanceled( false )
+    {
+    }
+
+    void cancel()
+    {
+        m_isCanceled = true;
+        stop();
+        m_isCanceled = false;
+    }
+
+  protected:
+    void advance( qreal value ) override
+    {
+        const qreal from = m_animator->from();
+        m_animator->setValue( from + ( m_animator->to() - from ) * value );
+    }
+
+    void done() override
+    {
+        if ( !m_isCanceled )
+            Q_EMIT m_animator->finished();
+    }
+
+  private:
+    QskRenderAnimator* m_animator;
+    bool m_isCanceled;
+};
+
+class QskRenderAnimator::PrivateData
+{
+  public:
+    PrivateData( QskRenderAnimator* animator )
+        : property( Opacity )
+        , from( 0.0 )
+        , to( 1.0 )
+        , duration( 200 )
+        , fallback( animator )
+    {
+    }
+
+    QPointer< QQuickItem > target;
+    Property property;
+
+    qreal from;
+    qreal to;
+
+    int duration;
+    QEasingCurve easingCurve;
+
+    QPointer< QQuickAnimator > quickAnimator;
+    QskRenderAnimatorFallback fallback;
+};
+
+QskRenderAnimator::QskRenderAnimator( QObject* parent )
+    : QObject( parent )
+    , m_data( new PrivateData( this ) )
+{
+}
+
+QskRenderAnimator::QskRenderAnimator(
+        QQuickItem* target, Property property, QObject* parent )
+    : QskRenderAnimator( parent )
+{
+    m_data->target = target;
+    m_data->property = property;
+}
+
+QskRenderAnimator::~QskRenderAnimator()
+{
+    stop();
+}
+
+void QskRenderAnimator::setTarget( QQuickItem* target )
+{
+    if ( target != m_data->target )
+    {
+        stop();
+        m_data->target = target;
+    }
+}
+
+QQuickItem* QskRenderAnimator::target() const
+{
+    return m_data->target;
+}
+
+void QskRenderAnimator::setAnimatedProperty( Property property )
+{
+    if ( property != m_data->property )
+    {
+        stop();
+        m_data->property = property;
+    }
+}
+
+QskRenderAnimator::Property QskRenderAnimator::animatedProperty() const
+{
+    return m_data->property;
+}
+
+void QskRenderAnimator::setFrom( qreal from )
+{
+    m_data->from = from;
+}
+
+qreal QskRenderAnimator::from() const
+{
+    return m_data->from;
+}
+
+void QskRenderAnimator::setTo( qreal to )
+{
+    m_data->to = to;
+}
+
+qreal QskRenderAnimator::to() const
+{
+    return m_data->to;
+}
+
+void QskRenderAnimator::setDuration( int ms )
+{
+    m_data->duration = ms;
+}
+
+int QskRenderAnimator::duration() const
+{
+    return m_data->duration;
+}
+
+void QskRenderAnimator::setEasingCurve( QEasingCurve::Type type )
+{
+    m_data->easingCurve.setType( type );
+}
+
+void QskRenderAnimator::setEasingCurve( const QEasingCurve& easingCurve )
+{
+    m_data->easingCurve = easingCurve;
+}
+
+const QEasingCurve& QskRenderAnimator::easingCurve() const
+{
+    return m_data->easingCurve;
+}
+
+bool QskRenderAnimator::isRunning() const
+{
+    if ( m_data->quickAnimator )
+        return m_data->quickAnimator->isRunning();
+
+    return m_data->fallback.isRunning();
+}
+
+bool QskRenderAnimator::isThreaded()
+{
+    /*
+        With other render loops QQuickAnimator runs on the GUI thread too,
+        but being driven by QAnimationDriver. Then we prefer to have
+        all our animators being synchronized by the QskAnimator driver.
+     */
+    const auto renderLoop = QSGRenderLoop::instance();
+    return renderLoop && renderLoop->inherits( "QSGThreadedRenderLoop" );
+}
+
+void QskRenderAnimator::start()
+{
+    stop();
+
+    auto target = m_data->target.data();
+    if ( target == nullptr )
+        return;
+
+    if ( target->window() == nullptr || m_data->duration <= 0 )
+    {
+        setValue( m_data->to );
+        Q_EMIT finished();
+
+        return;
+    }
+
+    if ( isThreaded() )
+    {
+        auto animator = qskCreateQuickAnimator( m_data->property );
+
+        animator->setTargetItem( target );
+        animator->setFrom( m_data->from );
+        animator->setTo( m_data->to );
+        animator->setDuration( m_data->duration );
+        animator->setEasing( m_data->easingCurve );
+
+        connect( animator, &QQuickAbstractAnimation::stopped,
+            this, &QskRenderAnimator::finished );
+
+        m_data->quickAnimator = animator;
+        animator->start();
+    }
+    else
+    {
+        auto& fallback = m_data->fallback;
+
+        fallback.setWindow( target->window() );
+        fallback.setDuration( m_data->duration );
+        fallback.setEasingCurve( m_data->easingCurve );
+
+        setValue( m_data->from );
+        fallback.start();
+    }
+}
+
+void QskRenderAnimator::stop()
+{
+    if ( auto animator = m_data->quickAnimator.data() )
+    {
+        m_data->quickAnimator = nullptr;
+
+        /*
+            Stopping a QQuickAnimator syncs the current value
+            from the scene graph back to the item.
+         */
+        disconnect( animator, nullptr, this, nullptr );
+        animator->stop();
+        animator->deleteLater();
+    }
+
+    m_data->fallback.cancel();
+}
+
+void QskRenderAnimator::setValue( qreal value )
+{
+    auto target = m_data->target.data();
+    if ( target == nullptr )
+        return;
+
+    switch ( m_data->property )
+    {
+        case Opacity:
+            target->setOpacity( value );
+            break;
+
+        case X:
+            target->setX( value );
+            break;
+
+        case Y:
+            target->setY( value );
+            break;
+
+        case Scale:
+            target->setScale( value );
+            break;
+
+        case Rotation:
+            target->setRotation( value );
+            break;
+    }
+}
+
+#include "moc_QskRenderAnimator.cpp"
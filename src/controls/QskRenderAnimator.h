@@ -0,0 +1,88 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_RENDER_ANIMATOR_H
+#define QSK_RENDER_ANIMATOR_H
+
+#include "QskGlobal.h"
+
+#include <qeasingcurve.h>
+#include <qobject.h>
+#include <memory>
+
+class QQuickItem;
+
+/*
+    QskRenderAnimator animates the opacity or a transformation of an item.
+    With the threaded render loop it is advanced on the scene graph thread
+    - like QQuickAnimator - and continues, even when the GUI thread
+    is busy. The item properties are synced back, when the animation
+    has finished.
+
+    Otherwise the animator falls back to being advanced by the
+    QskAnimator driver.
+ */
+class QSK_EXPORT QskRenderAnimator : public QObject
+{
+    Q_OBJECT
+
+  public:
+    enum Property
+    {
+        Opacity,
+        X,
+        Y,
+        Scale,
+        Rotation
+    };
+
+    Q_ENUM( Property )
+
+    QskRenderAnimator( QObject* parent = nullptr );
+    QskRenderAnimator( QQuickItem*, Property, QObject* parent = nullptr );
+
+    ~QskRenderAnimator() override;
+
+    void setTarget( QQuickItem* );
+    QQuickItem* target() const;
+
+    void setAnimatedProperty( Property );
+    Property animatedProperty() const;
+
+    void setFrom( qreal );
+    qreal from() const;
+
+    void setTo( qreal );
+    qreal to() const;
+
+    void setDuration( int ms );
+    int duration() const;
+
+    void setEasingCurve( QEasingCurve::Type );
+    void setEasingCurve( const QEasingCurve& );
+    const QEasingCurve& easingCurve() const;
+
+    bool isRunning() const;
+
+    // advanced on the scene graph thread
+    static bool isThreaded();
+
+  public Q_SLOTS:
+    void start();
+    void stop();
+
+  Q_SIGNALS:
+    void finished();
+
+  private:
+    friend class QskRenderAnimatorFallback;
+
+    void setValue( qreal );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
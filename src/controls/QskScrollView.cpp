@@ -30,8 +30,7 @@ namespace
         FlickAnimator()
         {
             // skin hints: TODO
-            setDuration( 1000 );
-            setEasingCurve( QEasingCurve::OutCubic );
+            setTimeConstant( 325 );
         }
 
         void setScrollView( QskScrollView* scrollView )
@@ -43,6 +42,13 @@ namespace
         {
             const QPointF pos = m_scrollView->scrollPos();
             m_scrollView->setScrollPos( pos - QPointF( dx, -dy ) );
+
+            /*
+                Once we are stuck at the bounds there is no point
+                in advancing the remaining frames
+             */
+            if ( m_scrollView->scrollPos() == pos )
+                stop();
         }
 
       private:
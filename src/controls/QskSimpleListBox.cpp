@@ -7,21 +7,84 @@
 #include "QskAspect.h"
 
 #include <qfontmetrics.h>
+#include <qrunnable.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#include <qvector.h>
 
-static inline qreal qskMaxWidth(
+#include <map>
+
+namespace
+{
+    class MeasureJob final : public QRunnable
+    {
+      public:
+        MeasureJob( const QFont& font, const QStringList& list,
+                int from, int to, qreal* widths )
+            : m_font( font )
+            , m_list( list )
+            , m_from( from )
+            , m_to( to )
+            , m_widths( widths )
+        {
+        }
+
+        void run() override
+        {
+            const QFontMetricsF fm( m_font );
+
+            for ( int i = m_from; i < m_to; i++ )
+                m_widths[ i ] = fm.width( m_list[ i ] );
+        }
+
+      private:
+        const QFont m_font;
+        const QStringList& m_list;
+
+        const int m_from;
+        const int m_to;
+
+        qreal* m_widths;
+    };
+}
+
+static QVector< qreal > qskTextWidths(
     const QFont& font, const QStringList& list )
 {
-    const QFontMetricsF fm( font );
+    QVector< qreal > widths( list.size() );
+
+    /*
+        Measuring texts with QFontMetricsF is thread safe, so we can
+        distribute bulk inserts over a couple of threads. For small
+        lists the overhead of the threads does not pay off.
+     */
 
-    qreal max = 0.0;
-    for ( int i = 0; i < list.size(); i++ )
+    const int minChunkSize = 10000;
+    const int threadCount = qMin( QThread::idealThreadCount(),
+        list.size() / minChunkSize );
+
+    if ( threadCount > 1 )
     {
-        const qreal w = fm.width( list[ i ] );
-        if ( w > max )
-            max = w;
+        QThreadPool pool;
+        pool.setMaxThreadCount( threadCount );
+
+        const int chunkSize = ( list.size() + threadCount - 1 ) / threadCount;
+
+        for ( int from = 0; from < list.size(); from += chunkSize )
+        {
+            const int to = qMin( from + chunkSize, list.size() );
+            pool.start( new MeasureJob( font, list, from, to, widths.data() ) );
+        }
+
+        pool.waitForDone();
+    }
+    else
+    {
+        MeasureJob job( font, list, 0, list.size(), widths.data() );
+        job.run();
     }
 
-    return max;
+    return widths;
 }
 
 class QskSimpleListBox::PrivateData
@@ -33,11 +96,61 @@ class QskSimpleListBox::PrivateData
     {
     }
 
+    /*
+        The width of each entry is stored, so that we never have to
+        measure an entry twice. The number of entries for each width is
+        counted in a sorted map, what allows to find the maximum width
+        after removing entries without rescanning all of them.
+     */
+
+    inline void insertWidths( int index, const QVector< qreal >& values )
+    {
+        if ( index < 0 || index >= widths.size() )
+        {
+            widths += values;
+        }
+        else
+        {
+            widths.insert( index, values.size(), 0.0 );
+            std::copy( values.begin(), values.end(), widths.begin() + index );
+        }
+
+        for ( const auto w : values )
+            widthCounts[ w ]++;
+    }
+
+    inline void removeWidths( int from, int to )
+    {
+        for ( int i = from; i <= to; i++ )
+        {
+            auto it = widthCounts.find( widths[ i ] );
+            if ( it != widthCounts.end() && --it->second <= 0 )
+                widthCounts.erase( it );
+        }
+
+        widths.remove( from, to - from + 1 );
+    }
+
+    inline void clearWidths()
+    {
+        widths.clear();
+        widthCounts.clear();
+    }
+
+    inline qreal maxWidth() const
+    {
+        return widthCounts.empty() ? 0.0 : widthCounts.rbegin()->first;
+    }
+
     // one column at the moment only
     qreal maxTextWidth;
     qreal columnWidthHint;
 
     QStringList entries;
+
+    // only maintained, when having no columnWidthHint
+    QVector< qreal > widths;
+    std::map< qreal, int > widthCounts;
 };
 
 QskSimpleListBox::QskSimpleListBox( QQuickItem* parent )
@@ -78,9 +191,21 @@ void QskSimpleListBox::setColumnWidthHint( int column, qreal width )
         m_data->columnWidthHint = qMax( width, qreal( 0.0 ) );
 
         if ( m_data->columnWidthHint > 0.0 )
+        {
+            m_data->clearWidths();
             m_data->maxTextWidth = m_data->columnWidthHint;
+        }
         else
-            m_data->maxTextWidth = qskMaxWidth( effectiveFont( Text ), m_data->entries );
+        {
+            if ( m_data->widths.size() != m_data->entries.size() )
+            {
+                m_data->clearWidths();
+                m_data->insertWidths( -1,
+                    qskTextWidths( effectiveFont( Text ), m_data->entries ) );
+            }
+
+            m_data->maxTextWidth = m_data->maxWidth();
+        }
 
         updateScrollableSize();
     }
@@ -101,9 +226,8 @@ void QskSimpleListBox::insert( const QStringList& list, int index )
 
     if ( m_data->columnWidthHint <= 0.0 )
     {
-        const auto w = qskMaxWidth( effectiveFont( Text ), list );
-        if ( w > m_data->maxTextWidth )
-            m_data->maxTextWidth = w;
+        m_data->insertWidths( index, qskTextWidths( effectiveFont( Text ), list ) );
+        m_data->maxTextWidth = m_data->maxWidth();
     }
 
     if ( m_data->entries.isEmpty() )
@@ -132,7 +256,10 @@ void QskSimpleListBox::setEntries( const QStringList& entries )
     m_data->entries.clear();
 
     if ( m_data->columnWidthHint <= 0.0 )
+    {
+        m_data->clearWidths();
         m_data->maxTextWidth = 0.0;
+    }
 
     insert( entries, -1 );
 }
@@ -146,7 +273,9 @@ void QskSimpleListBox::insert( const QString& text, int index )
 {
     if ( m_data->columnWidthHint <= 0.0 )
     {
-        const auto w = QFontMetricsF( effectiveFont( Cell ) ).width( text );
+        const auto w = QFontMetricsF( effectiveFont( Text ) ).width( text );
+        m_data->insertWidths( index, { w } );
+
         if ( w > m_data->maxTextWidth )
             m_data->maxTextWidth = w;
     }
@@ -166,17 +295,12 @@ void QskSimpleListBox::removeAt( int index )
     if ( index < 0 || index >= entries.size() )
         return;
 
-    if ( m_data->columnWidthHint <= 0.0 )
-    {
-        const QFontMetricsF fm( effectiveFont( Cell ) );
-        const auto w = fm.width( entries[ index ] );
+    entries.removeAt( index );
 
-        if ( w >= m_data->maxTextWidth )
-            m_data->maxTextWidth = qskMaxWidth( effectiveFont( Text ), entries );
-    }
-    else
+    if ( m_data->columnWidthHint <= 0.0 )
     {
-        entries.removeAt( index );
+        m_data->removeWidths( index, index );
+        m_data->maxTextWidth = m_data->maxWidth();
     }
 
     propagateEntries();
@@ -204,11 +328,14 @@ void QskSimpleListBox::removeBulk( int from, int to )
     if ( to < from )
         return;
 
-    for ( int i = to; i >= from; i-- )
-        m_data->entries.removeAt( i );
+    m_data->entries.erase( m_data->entries.begin() + from,
+        m_data->entries.begin() + to + 1 );
 
     if ( m_data->columnWidthHint <= 0.0 )
-        m_data->maxTextWidth = qskMaxWidth( effectiveFont( Text ), m_data->entries );
+    {
+        m_data->removeWidths( from, to );
+        m_data->maxTextWidth = m_data->maxWidth();
+    }
 
     propagateEntries();
 
@@ -248,7 +375,10 @@ void QskSimpleListBox::clear()
     m_data->entries.clear();
 
     if ( m_data->columnWidthHint <= 0.0 )
+    {
+        m_data->clearWidths();
         m_data->maxTextWidth = 0.0;
+    }
 
     propagateEntries();
     setSelectedRow( -1 );
@@ -43,8 +43,15 @@ inline const QVariant* qskResolvedHint( QskAspect::Aspect aspect,
     }
 }
 
+static inline quint16 qskPrimitiveKey(
+    QskAspect::Subcontrol subControl, QskAspect::Type type )
+{
+    return static_cast< quint16 >( ( subControl << 3 ) | type );
+}
+
 QskSkinHintTable::QskSkinHintTable()
     : m_hints( nullptr )
+    , m_statefulPrimitives( nullptr )
     , m_animatorCount( 0 )
     , m_hasStates( false )
 {
@@ -52,6 +59,7 @@ QskSkinHintTable::QskSkinHintTable()
 
 QskSkinHintTable::QskSkinHintTable( const QskSkinHintTable& other )
     : m_hints( nullptr )
+    , m_statefulPrimitives( nullptr )
     , m_animatorCount( other.m_animatorCount )
     , m_hasStates( other.m_hasStates )
 {
@@ -62,6 +70,7 @@ QskSkinHintTable::QskSkinHintTable( const QskSkinHintTable& other )
 QskSkinHintTable::~QskSkinHintTable()
 {
     delete m_hints;
+    delete m_statefulPrimitives;
 }
 
 QskSkinHintTable& QskSkinHintTable::operator=( const QskSkinHintTable& other )
@@ -69,6 +78,8 @@ QskSkinHintTable& QskSkinHintTable::operator=( const QskSkinHintTable& other )
     m_animatorCount = other.m_animatorCount;
     m_hasStates = other.m_hasStates;
 
+    invalidateStatefulPrimitives();
+
     if ( other.m_hints )
     {
         if ( m_hints == nullptr )
@@ -105,6 +116,8 @@ void QskSkinHintTable::setHint( QskAspect::Aspect aspect, const QVariant& skinHi
         m_hints->emplace( aspect, skinHint );
         if ( aspect.isAnimator() )
             m_animatorCount++;
+        else if ( aspect.state() )
+            invalidateStatefulPrimitives();
     }
     else if ( it->second != skinHint )
     {
@@ -124,6 +137,8 @@ void QskSkinHintTable::removeHint( QskAspect::Aspect aspect )
     {
         if ( aspect.isAnimator() )
             m_animatorCount--;
+        else if ( aspect.state() )
+            invalidateStatefulPrimitives();
 
         if ( m_hints->empty() )
         {
@@ -139,6 +154,8 @@ void QskSkinHintTable::clear()
     m_hints = nullptr;
 
     m_animatorCount = 0;
+
+    invalidateStatefulPrimitives();
 }
 
 const QVariant* QskSkinHintTable::resolvedHint(
@@ -183,3 +200,36 @@ QskAspect::Aspect QskSkinHintTable::resolvedAnimator(
 
     return QskAspect::Aspect();
 }
+
+quint32 QskSkinHintTable::statefulPrimitives(
+    QskAspect::Subcontrol subControl, QskAspect::Type type ) const
+{
+    if ( m_hints == nullptr || !m_hasStates )
+        return 0;
+
+    if ( m_statefulPrimitives == nullptr )
+    {
+        m_statefulPrimitives = new PrimitiveMap();
+
+        for ( const auto& entry : *m_hints )
+        {
+            const auto aspect = entry.first;
+
+            if ( aspect.state() && !aspect.isAnimator()
+                && aspect.primitive() <= QskAspect::LastPrimitive )
+            {
+                const auto key = qskPrimitiveKey( aspect.subControl(), aspect.type() );
+                ( *m_statefulPrimitives )[ key ] |= ( 1u << aspect.primitive() );
+            }
+        }
+    }
+
+    const auto it = m_statefulPrimitives->find( qskPrimitiveKey( subControl, type ) );
+    return ( it != m_statefulPrimitives->cend() ) ? it->second : 0;
+}
+
+void QskSkinHintTable::invalidateStatefulPrimitives()
+{
+    delete m_statefulPrimitives;
+    m_statefulPrimitives = nullptr;
+}
@@ -82,12 +82,25 @@ class QSK_EXPORT QskSkinHintTable
     QskAspect::Aspect resolvedAnimator(
         QskAspect::Aspect, QskAnimationHint& ) const;
 
+    /*
+        A bit mask of the primitives, that have hints with state bits
+        for a subcontrol/type. All other primitives resolve to the same
+        value for any state.
+     */
+    quint32 statefulPrimitives( QskAspect::Subcontrol, QskAspect::Type ) const;
+
   private:
+    void invalidateStatefulPrimitives();
+
     static QVariant invalidHint;
 
     typedef std::unordered_map< QskAspect::Aspect, QVariant > HintMap;
     HintMap* m_hints;
 
+    // lazily built from m_hints
+    typedef std::unordered_map< quint16, quint32 > PrimitiveMap;
+    mutable PrimitiveMap* m_statefulPrimitives;
+
     quint16 m_animatorCount;
     bool m_hasStates : 1;
 };
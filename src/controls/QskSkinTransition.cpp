@@ -1,10 +1,11 @@
 #include "QskSkinTransition.h"
 #include "QskColorFilter.h"
 #include "QskControl.h"
-#include "QskHintAnimator.h"
 #include "QskSkin.h"
 #include "QskSkinHintTable.h"
+#include "QskVariantAnimator.h"
 
+#include <qcolor.h>
 #include <qglobalstatic.h>
 #include <qguiapplication.h>
 #include <qobject.h>
@@ -12,6 +13,7 @@
 #include <qvector.h>
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace
@@ -52,6 +54,89 @@ namespace
     };
 }
 
+namespace
+{
+    /*
+        The controls, that are attached to a window, indexed by
+        their subcontrols. The subcontrols are resolved, when needed
+        for the first time: controls enter a window often before
+        being completely constructed.
+     */
+    class ControlIndex
+    {
+      public:
+        void insert( QskControl* control )
+        {
+            remove( control );
+
+            m_controls.insert( control );
+            m_pending.insert( control );
+        }
+
+        void remove( QskControl* control )
+        {
+            if ( m_controls.erase( control ) == 0 )
+                return;
+
+            if ( m_pending.erase( control ) > 0 )
+                return;
+
+            auto it = m_subControls.find( control );
+            if ( it != m_subControls.end() )
+            {
+                for ( const auto subControl : it->second )
+                    m_buckets[ subControl ].erase( control );
+
+                m_subControls.erase( it );
+            }
+        }
+
+        inline const std::unordered_set< QskControl* >& controls() const
+        {
+            return m_controls;
+        }
+
+        const std::unordered_set< QskControl* >& controls(
+            QskAspect::Subcontrol subControl )
+        {
+            resolvePending();
+
+            auto it = m_buckets.find( subControl );
+            if ( it != m_buckets.end() )
+                return it->second;
+
+            static const std::unordered_set< QskControl* > noControls;
+            return noControls;
+        }
+
+      private:
+        void resolvePending()
+        {
+            for ( auto control : m_pending )
+            {
+                const auto subControls = control->subControls();
+
+                for ( const auto subControl : subControls )
+                    m_buckets[ subControl ].insert( control );
+
+                m_subControls.emplace( control, subControls );
+            }
+
+            m_pending.clear();
+        }
+
+        std::unordered_set< QskControl* > m_controls;
+        std::unordered_set< QskControl* > m_pending;
+
+        std::unordered_map< const QskControl*,
+            QVector< QskAspect::Subcontrol > > m_subControls;
+
+        std::unordered_map< int, std::unordered_set< QskControl* > > m_buckets;
+    };
+}
+
+Q_GLOBAL_STATIC( ControlIndex, qskControlIndex )
+
 static QVector< AnimatorCandidate > qskAnimatorCandidates(
     QskSkinTransition::Type mask,
     const QskSkinHintTable& oldTable,
@@ -157,11 +242,90 @@ static QVector< AnimatorCandidate > qskAnimatorCandidates(
 
 namespace
 {
+    /*
+        All animators of a skin transition share duration and easing curve.
+        So the group is driven by one animator, that evaluates the progress
+        once per frame and then interpolates all values in a row.
+     */
+    class ValueInterpolator final : public QskVariantAnimator
+    {
+      public:
+        // never started, but advanced by the animator of the group
+        using QskVariantAnimator::setup;
+        using QskVariantAnimator::advance;
+    };
+
+    class AnimatorGroup;
+
+    class GroupAnimator final : public QskAnimator
+    {
+      public:
+        GroupAnimator( AnimatorGroup* group )
+            : m_group( group )
+        {
+        }
+
+      protected:
+        void advance( qreal progress ) override;
+
+      private:
+        AnimatorGroup* m_group;
+    };
+
+    class HintLocation
+    {
+      public:
+        bool isColor; // m_colorValues or m_hintInterpolators
+        int index;
+    };
+
+    inline bool qskIsRgbColor( const QVariant& value )
+    {
+        if ( value.userType() != QMetaType::QColor )
+            return false;
+
+        const auto color = value.value< QColor >();
+        return color.isValid() && ( color.spec() == QColor::Rgb );
+    }
+
+    /*
+        Interpolating the channels of 2 colors in parallel, using 16 bits
+        for each of them. The loop does not branch and can be vectorized
+        by the compiler.
+
+        Easing curves like OutBack overshoot [0.0, 1.0], what would
+        overflow the channels. So the progress is clamped, what is the
+        same as bounding each channel to the range of the 2 colors.
+     */
+    void qskInterpolateColors( const QRgb* from,
+        const QRgb* to, QRgb* values, int count, qreal progress )
+    {
+        progress = qBound( qreal( 0.0 ), progress, qreal( 1.0 ) );
+
+        const quint32 r2 = quint32( progress * 256.0 );
+        const quint32 r1 = 256 - r2;
+
+        for ( int i = 0; i < count; i++ )
+        {
+            const quint32 c1 = from[ i ];
+            const quint32 c2 = to[ i ];
+
+            const quint32 rb = ( ( c1 & 0x00ff00ff ) * r1
+                + ( c2 & 0x00ff00ff ) * r2 ) >> 8;
+
+            const quint32 ag = ( ( c1 >> 8 ) & 0x00ff00ff ) * r1
+                + ( ( c2 >> 8 ) & 0x00ff00ff ) * r2;
+
+            values[ i ] = ( rb & 0x00ff00ff ) | ( ag & 0xff00ff00 );
+        }
+    }
+
     class AnimatorGroup
     {
       public:
         AnimatorGroup( QQuickWindow* window = nullptr )
             : m_window( window )
+            , m_animator( this )
         {
         }
 
@@ -172,40 +336,67 @@ namespace
 
         void start()
         {
-            for ( auto& it : m_hintAnimatorMap )
-                it.second.start();
+            for ( auto& interpolator : m_hintInterpolators )
+                interpolator.setup();
+
+            for ( auto& interpolator : m_graphicFilterInterpolators )
+                interpolator.setup();
+
+            m_colorValues.resize( m_colors[ 0 ].size() );
+            m_colors[ 2 ] = m_colors[ 0 ];
+
+            for ( int i = 0; i < m_colorValues.size(); i++ )
+                m_colorValues[ i ] = QColor::fromRgba( m_colors[ 0 ][ i ] );
+
+            m_animator.setWindow( m_window );
+            m_animator.start();
+        }
 
-            for ( auto& it : m_graphicFilterAnimatorMap )
-                it.second.start();
+        inline bool isRunning() const
+        {
+            return m_animator.isRunning();
         }
 
-        bool isRunning() const
+        void advance( qreal progress )
         {
-            if ( !m_hintAnimatorMap.empty() )
-            {
-                const auto& animator = m_hintAnimatorMap.begin()->second;
-                if ( animator.isRunning() )
-                    return true;
-            }
+            if ( qFuzzyCompare( progress, 1.0 ) )
+                progress = 1.0;
 
-            if ( !m_graphicFilterAnimatorMap.empty() )
+            const int count = m_colorValues.size();
+            if ( count > 0 )
             {
-                const auto& animator = m_graphicFilterAnimatorMap.begin()->second;
-                if ( animator.isRunning() )
-                    return true;
+                qskInterpolateColors( m_colors[ 0 ].constData(),
+                    m_colors[ 1 ].constData(), m_colors[ 2 ].data(), count, progress );
+
+                // the values have been detached before, no allocations here
+                for ( int i = 0; i < count; i++ )
+                {
+                    *static_cast< QColor* >( m_colorValues[ i ].data() ) =
+                        QColor::fromRgba( m_colors[ 2 ][ i ] );
+                }
             }
 
-            return false;
+            for ( auto& interpolator : m_hintInterpolators )
+                interpolator.advance( progress );
+
+            for ( auto& interpolator : m_graphicFilterInterpolators )
+                interpolator.advance( progress );
         }
 
         inline QVariant animatedHint( QskAspect::Aspect aspect ) const
         {
-            auto it = m_hintAnimatorMap.find( aspect );
-            if ( it != m_hintAnimatorMap.cend() )
+            if ( isRunning() )
             {
-                const auto& animator = it->second;
-                if ( animator.isRunning() )
-                    return animator.currentValue();
+                auto it = m_hintLocations.find( aspect );
+                if ( it != m_hintLocations.cend() )
+                {
+                    const auto& location = it->second;
+
+                    if ( location.isColor )
+                        return m_colorValues[ location.index ];
+
+                    return m_hintInterpolators[ location.index ].currentValue();
+                }
             }
 
             return QVariant();
@@ -213,12 +404,11 @@ namespace
 
         inline QVariant animatedGraphicFilter( int graphicRole ) const
         {
-            auto it = m_graphicFilterAnimatorMap.find( graphicRole );
-            if ( it != m_graphicFilterAnimatorMap.cend() )
+            if ( isRunning() )
             {
-                const auto& animator = it->second;
-                if ( animator.isRunning() )
-                    return animator.currentValue();
+                auto it = m_graphicFilterIndexes.find( graphicRole );
+                if ( it != m_graphicFilterIndexes.cend() )
+                    return m_graphicFilterInterpolators[ it->second ].currentValue();
             }
 
             return QVariant();
@@ -242,43 +432,62 @@ namespace
 
                 if ( f1 != f2 )
                 {
-                    QskVariantAnimator animator;
-                    animator.setWindow( m_window );
-                    animator.setDuration( animatorHint.duration );
-                    animator.setEasingCurve( animatorHint.type );
-                    animator.setStartValue( QVariant::fromValue( f1 ) );
-                    animator.setEndValue( QVariant::fromValue( f2 ) );
-
-                    m_graphicFilterAnimatorMap.emplace( it2->first, animator );
+                    ValueInterpolator interpolator;
+                    interpolator.setStartValue( QVariant::fromValue( f1 ) );
+                    interpolator.setEndValue( QVariant::fromValue( f2 ) );
+
+                    m_graphicFilterIndexes.emplace( it2->first,
+                        int( m_graphicFilterInterpolators.size() ) );
+
+                    m_graphicFilterInterpolators.push_back( interpolator );
                 }
             }
+
+            setAnimationHint( animatorHint );
         }
 
-        void addAnimators( QQuickItem* item, const QskAnimationHint& animatorHint,
+        void addAnimators( const QskAnimationHint& animatorHint,
             const QVector< AnimatorCandidate >& candidates, QskSkin* skin )
         {
-            if ( !item->isVisible() )
-                return;
+            using namespace QskAspect;
+
+            std::unordered_map< int, QVector< int > > subControlCandidates;
+            for ( int i = 0; i < candidates.size(); i++ )
+                subControlCandidates[ candidates[ i ].aspect.subControl() ] += i;
+
+            // only the controls, that are interested in the subcontrols
+            auto& controlIndex = *qskControlIndex;
 
-            if ( auto control = qskControlCast( item ) )
+            for ( const auto& entry : subControlCandidates )
             {
-                if ( control->isInitiallyPainted() && ( skin == control->effectiveSkin() ) )
+                const auto subControl = static_cast< Subcontrol >( entry.first );
+
+                const auto& controls = ( subControl == QskAspect::Control )
+                    ? controlIndex.controls() : controlIndex.controls( subControl );
+
+                for ( auto control : controls )
                 {
-                    addControlAnimators( control, animatorHint, candidates );
-#if 1
-                    /*
-                        As it is hard to identify which controls depend on the animated
-                        graphic filters we schedule an initial update and let the
-                        controls do the rest: see QskSkinnable::effectiveGraphicFilter
-                     */
-                    control->update();
-#endif
+                    if ( isAffected( control, skin ) )
+                    {
+                        for ( const int index : entry.second )
+                            addControlAnimator( control, candidates[ index ], animatorHint );
+                    }
                 }
             }
 
-            const auto children = item->childItems();
-            for ( auto child : children )
-                addAnimators( child, animatorHint, candidates, skin );
+            if ( !m_graphicFilterInterpolators.empty() )
+            {
+                /*
+                    As it is hard to identify which controls depend on the animated
+                    graphic filters we schedule an initial update and let the
+                    controls do the rest: see QskSkinnable::effectiveGraphicFilter
+                 */
+                for ( auto control : controlIndex.controls() )
+                {
+                    if ( isAffected( control, skin ) )
+                        control->update();
+                }
+            }
         }
 
         void update()
@@ -301,92 +510,112 @@ namespace
 
       private:
 
-        void addControlAnimators( QskControl* control, const QskAnimationHint& animatorHint,
-            const QVector< AnimatorCandidate >& candidates )
+        bool isAffected( QskControl* control, const QskSkin* skin )
         {
-            const auto subControls = control->subControls();
-
-            for ( const auto& candidate : candidates )
+            auto it = m_affectedControls.find( control );
+            if ( it == m_affectedControls.end() )
             {
-                using namespace QskAspect;
+                const bool isAffected = ( control->window() == m_window )
+                    && control->isVisible() && control->isInitiallyPainted()
+                    && ( skin == control->effectiveSkin() );
 
-                if ( candidate.aspect.type() != Metric )
-                {
-                    if ( !( control->flags() & QQuickItem::ItemHasContents ) )
-                    {
-                        // while metrics might have an effect on layouts, we
-                        // can safely ignore others for controls without content
-                        continue;
-                    }
-                }
+                it = m_affectedControls.emplace( control, isAffected ).first;
+            }
 
-                const Subcontrol subControl = candidate.aspect.subControl();
-                if ( subControl != control->effectiveSubcontrol( subControl ) )
-                {
-                    // The control uses subcontrol redirection, so we can assume it
-                    // is not interested in this subcontrol.
-                    continue;
-                }
+            return it->second;
+        }
 
-                if ( subControl != QskAspect::Control )
-                {
-                    if ( !subControls.contains( subControl ) )
-                    {
-                        // the control is not interested in the aspect
-                        continue;
-                    }
-                }
-                else
+        void addControlAnimator( QskControl* control,
+            const AnimatorCandidate& candidate, const QskAnimationHint& animatorHint )
+        {
+            using namespace QskAspect;
+
+            if ( candidate.aspect.type() != Metric )
+            {
+                if ( !( control->flags() & QQuickItem::ItemHasContents ) )
                 {
-                    if ( !control->autoFillBackground() )
-                    {
-                        // no need to animate the background unless we show it
-                        continue;
-                    }
+                    // while metrics might have an effect on layouts, we
+                    // can safely ignore others for controls without content
+                    return;
                 }
+            }
 
-                QskAspect::Aspect a = candidate.aspect;
-                a.clearStates();
-                a.addState( control->skinState() );
-
-                const QskSkinHintStatus requestState = control->hintStatus( a );
+            const Subcontrol subControl = candidate.aspect.subControl();
+            if ( subControl != control->effectiveSubcontrol( subControl ) )
+            {
+                // The control uses subcontrol redirection, so we can assume it
+                // is not interested in this subcontrol.
+                return;
+            }
 
-                if ( requestState.source != QskSkinHintStatus::Skin )
+            if ( subControl == QskAspect::Control )
+            {
+                if ( !control->autoFillBackground() )
                 {
-                    // The control does not resolve the aspect from the skin.
-                    continue;
+                    // no need to animate the background unless we show it
+                    return;
                 }
+            }
 
-                if ( candidate.aspect != requestState.aspect )
-                {
-                    // the aspect was resolved to something else
-                    continue;
-                }
+            QskAspect::Aspect a = candidate.aspect;
+            a.clearStates();
+            a.addState( control->skinState() );
+
+            const QskSkinHintStatus requestState = control->hintStatus( a );
 
-                addAnimator( control->window(), candidate, animatorHint );
-                storeUpdateInfo( control, candidate.aspect );
+            if ( requestState.source != QskSkinHintStatus::Skin )
+            {
+                // The control does not resolve the aspect from the skin.
+                return;
+            }
+
+            if ( candidate.aspect != requestState.aspect )
+            {
+                // the aspect was resolved to something else
+                return;
             }
+
+            addAnimator( candidate, animatorHint );
+            storeUpdateInfo( control, candidate.aspect );
         }
 
-        void addAnimator( QQuickWindow* window,
-            const AnimatorCandidate& candidate, QskAnimationHint animationHint )
+        void addAnimator( const AnimatorCandidate& candidate,
+            const QskAnimationHint& animationHint )
         {
-            auto it = m_hintAnimatorMap.find( candidate.aspect );
-            if ( it != m_hintAnimatorMap.end() )
+            if ( m_hintLocations.find( candidate.aspect ) != m_hintLocations.end() )
                 return; // already there
 
-            it = m_hintAnimatorMap.emplace( candidate.aspect, QskHintAnimator() ).first;
-            auto& animator = it->second;
+            HintLocation location;
+
+            if ( qskIsRgbColor( candidate.from ) && qskIsRgbColor( candidate.to ) )
+            {
+                location.isColor = true;
+                location.index = m_colors[ 0 ].size();
+
+                m_colors[ 0 ] += candidate.from.value< QColor >().rgba();
+                m_colors[ 1 ] += candidate.to.value< QColor >().rgba();
+            }
+            else
+            {
+                location.isColor = false;
+                location.index = int( m_hintInterpolators.size() );
+
+                ValueInterpolator interpolator;
+                interpolator.setStartValue( candidate.from );
+                interpolator.setEndValue( candidate.to );
 
-            animator.setAspect( candidate.aspect );
-            animator.setStartValue( candidate.from );
-            animator.setEndValue( candidate.to );
+                m_hintInterpolators.push_back( interpolator );
+            }
 
-            animator.setDuration( animationHint.duration );
-            animator.setEasingCurve( animationHint.type );
+            m_hintLocations.emplace( candidate.aspect, location );
 
-            animator.setControl( nullptr );
-            animator.setWindow( window );
+            setAnimationHint( animationHint );
+        }
+
+        inline void setAnimationHint( const QskAnimationHint& animationHint )
+        {
+            m_animator.setDuration( animationHint.duration );
+            m_animator.setEasingCurve( animationHint.type );
         }
 
         inline void storeUpdateInfo( QskControl* control, QskAspect::Aspect aspect )
@@ -408,11 +637,30 @@ namespace
         }
 
         QQuickWindow* m_window;
-        std::unordered_map< QskAspect::Aspect, QskHintAnimator > m_hintAnimatorMap;
-        std::unordered_map< int, QskVariantAnimator > m_graphicFilterAnimatorMap;
+        GroupAnimator m_animator;
+
+        std::unordered_map< QskAspect::Aspect, HintLocation > m_hintLocations;
+
+        // colors, that can be interpolated as QRgb: from, to, current
+        QVector< QRgb > m_colors[ 3 ];
+        QVector< QVariant > m_colorValues;
+
+        std::vector< ValueInterpolator > m_hintInterpolators;
+
+        std::unordered_map< int, int > m_graphicFilterIndexes;
+        std::vector< ValueInterpolator > m_graphicFilterInterpolators;
+
         std::vector< UpdateInfo > m_updateInfos; // vector: for fast iteration
+
+        // only needed, while adding the animators
+        std::unordered_map< const QskControl*, bool > m_affectedControls;
     };
 
+    void GroupAnimator::advance( qreal progress )
+    {
+        m_group->advance( progress );
+    }
+
     class AnimatorGroups : public QObject
     {
         Q_OBJECT
@@ -630,12 +878,11 @@ void QskSkinTransition::process()
                 }
 
                 /*
-                   finally we schedule the animators the hard way by running
-                   over the the item trees.
+                   finally we schedule the animators for the controls,
+                   that are interested in the subcontrols of the candidates
                  */
 
-                group->addAnimators( quickWindow->contentItem(),
-                    m_animationHint, candidates, m_skins[ 1 ] );
+                group->addAnimators( m_animationHint, candidates, m_skins[ 1 ] );
 
                 qskSkinAnimator->add( group );
             }
@@ -665,6 +912,17 @@ QVariant QskSkinTransition::animatedHint(
     return QVariant();
 }
 
+void QskSkinTransition::registerControl( QskControl* control )
+{
+    qskControlIndex->insert( control );
+}
+
+void QskSkinTransition::unregisterControl( QskControl* control )
+{
+    if ( qskControlIndex.exists() )
+        qskControlIndex->remove( control );
+}
+
 QVariant QskSkinTransition::animatedGraphicFilter(
     const QQuickWindow* window, int graphicRole )
 {
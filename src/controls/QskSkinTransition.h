@@ -5,6 +5,7 @@
 #include "QskAspect.h"
 #include <qquickwindow.h>
 
+class QskControl;
 class QskSkin;
 
 class QSK_EXPORT QskSkinTransition
@@ -39,6 +40,10 @@ class QSK_EXPORT QskSkinTransition
     static QVariant animatedHint( const QQuickWindow*, QskAspect::Aspect );
     static QVariant animatedGraphicFilter( const QQuickWindow*, int graphicRole );
 
+    // called by QskControl, when entering/leaving a window
+    static void registerControl( QskControl* );
+    static void unregisterControl( QskControl* );
+
   protected:
     virtual void updateSkin( QskSkin*, QskSkin* );
 
@@ -807,6 +807,9 @@ void QskSkinnable::setSkinState( QskAspect::State newState )
     {
         const auto placement = effectivePlacement();
 
+        const auto& skinTable = effectiveSkin()->hintTable();
+        const auto& localTable = m_data->hintTable;
+
         const auto subControls = control->subControls();
         for ( const auto subControl : subControls )
         {
@@ -814,12 +817,22 @@ void QskSkinnable::setSkinState( QskAspect::State newState )
 
             Aspect aspect = subControl | placement;
 
-            const auto& skinTable = effectiveSkin()->hintTable();
-
             for ( int i = 0; i <= LastType; i++ )
             {
                 const auto type = static_cast< Type >( i );
 
+                /*
+                    Only primitives with state dependent hints might
+                    differ between the states. The masks are cached
+                    by the tables, so we can skip most of the
+                    subcontrol/type combinations without any lookup.
+                 */
+                quint32 primitives = skinTable.statefulPrimitives( subControl, type )
+                    | localTable.statefulPrimitives( subControl, type );
+
+                if ( primitives == 0 )
+                    continue;
+
                 const auto hint = effectiveAnimation( type, subControl, newState );
 
                 if ( hint.duration > 0 )
@@ -828,8 +841,11 @@ void QskSkinnable::setSkinState( QskAspect::State newState )
                         Starting an animator for all primitives,
                         that differ between the states
                      */
-                    for ( uint primitive = 0; primitive <= LastPrimitive; primitive++ )
+                    for ( uint primitive = 0; primitives != 0; primitive++, primitives >>= 1 )
                     {
+                        if ( !( primitives & 1 ) )
+                            continue;
+
                         aspect.setPrimitive( type, primitive );
 
                         Aspect a1 = aspect | m_data->skinState;
@@ -837,7 +853,7 @@ void QskSkinnable::setSkinState( QskAspect::State newState )
 
                         bool doTransition = true;
 
-                        if ( !m_data->hintTable.hasStates() )
+                        if ( !localTable.hasStates() )
                         {
                             /*
                                 The hints are found by stripping the state bits one by
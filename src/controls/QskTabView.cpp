@@ -128,6 +128,43 @@ int QskTabView::insertTab( int index, const QString& tabText, QQuickItem* item )
     return insertTab( index, new QskTabButton( tabText ), item );
 }
 
+int QskTabView::addTab( QskTabButton* button,
+    const std::function< QQuickItem*() >& factory )
+{
+    return insertTab( -1, button, factory );
+}
+
+int QskTabView::insertTab( int index, QskTabButton* button,
+    const std::function< QQuickItem*() >& factory )
+{
+    index = m_data->tabBar->insertTab( index, button );
+    m_data->stackBox->insertPage( index, factory );
+
+    return index;
+}
+
+int QskTabView::addTab( const QString& tabText,
+    const std::function< QQuickItem*() >& factory )
+{
+    return insertTab( -1, tabText, factory );
+}
+
+int QskTabView::insertTab( int index, const QString& tabText,
+    const std::function< QQuickItem*() >& factory )
+{
+    return insertTab( index, new QskTabButton( tabText ), factory );
+}
+
+void QskTabView::setPageUnloadDelay( int ms )
+{
+    m_data->stackBox->setPageUnloadDelay( ms );
+}
+
+int QskTabView::pageUnloadDelay() const
+{
+    return m_data->stackBox->pageUnloadDelay();
+}
+
 void QskTabView::removeTab( int index )
 {
     if ( index >= 0 && index < m_data->tabBar->count() )
@@ -165,12 +202,12 @@ QskTabButton* QskTabView::buttonAt( int index ) const
 
 QQuickItem* QskTabView::itemAt( int index ) const
 {
-    return m_data->stackBox->itemAtIndex( index );
+    return m_data->stackBox->pageAt( index );
 }
 
 int QskTabView::itemIndex( const QQuickItem* item )
 {
-    return m_data->stackBox->indexOf( item );
+    return m_data->stackBox->pageIndex( item );
 }
 
 int QskTabView::buttonIndex( const QskTabButton* button )
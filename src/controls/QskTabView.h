@@ -9,6 +9,8 @@
 #include "QskControl.h"
 #include "QskNamespace.h"
 
+#include <functional>
+
 class QskTabBar;
 class QskTabButton;
 
@@ -49,6 +51,16 @@ class QSK_EXPORT QskTabView : public QskControl
     int addTab( const QString&, QQuickItem* );
     int insertTab( int index, const QString&, QQuickItem* );
 
+    // pages, that are created, when the tab gets selected
+    int addTab( QskTabButton*, const std::function< QQuickItem*() >& );
+    int insertTab( int index, QskTabButton*, const std::function< QQuickItem*() >& );
+
+    int addTab( const QString&, const std::function< QQuickItem*() >& );
+    int insertTab( int index, const QString&, const std::function< QQuickItem*() >& );
+
+    void setPageUnloadDelay( int ms );
+    int pageUnloadDelay() const;
+
     void removeTab( int index );
     void clear();
 
@@ -10,18 +10,25 @@
 #include "QskColorFilter.h"
 #include "QskGradient.h"
 #include "QskMargins.h"
+#include "QskRgbValue.h"
 #include "QskTextColors.h"
 
-// Even if we don't use the standard Qt animation system we
-// use its registry of interpolators: why adding our own ...
-
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qline.h>
+#include <qmutex.h>
+#include <qquaternion.h>
+#include <qrect.h>
 #include <qvariantanimation.h>
-
-QSK_QT_PRIVATE_BEGIN
-#include <private/qvariantanimation_p.h>
-QSK_QT_PRIVATE_END
+#include <qvector2d.h>
+#include <qvector3d.h>
+#include <qvector4d.h>
 
 #if 1
+/*
+    QskVariantAnimator does not use them, but registering our
+    types makes them available for QVariantAnimation and QML.
+ */
 static void qskRegisterInterpolator()
 {
     qRegisterAnimationInterpolator< QskColorFilter >( QskColorFilter::interpolate );
@@ -36,32 +43,231 @@ static void qskRegisterInterpolator()
 Q_CONSTRUCTOR_FUNCTION( qskRegisterInterpolator )
 #endif
 
-#if defined( Q_CC_CLANG )
-#if __has_feature( address_sanitizer )
-#define QSK_DECL_INSANE __attribute__( ( no_sanitize( "undefined" ) ) )
-#endif
-#endif
-
-#if !defined( QSK_DECL_INSANE )
-#define QSK_DECL_INSANE
-#endif
-
-QSK_DECL_INSANE static inline QVariant qskInterpolate(
-    void ( *interpolator )(), const QVariant& from, const QVariant& to, qreal progress )
+namespace
 {
-#if 1
     /*
-        how to get rid of the reported runtime error from the clang sanitizer,
-        when calling F( const T&, ... ) as G( const void* ... ); TODO ...
+        QVariantAnimation offers the interpolators, that have been registered
+        by qRegisterAnimationInterpolator, by its protected interpolated() only.
+        The interpolator is selected, when setting the start/end values.
      */
-#endif
+    class VariantInterpolator final : public QVariantAnimation
+    {
+      public:
+        VariantInterpolator( const QVariant& from, const QVariant& to )
+        {
+            setStartValue( from );
+            setEndValue( to );
+        }
+
+        inline QVariant interpolate( const QVariant& from,
+            const QVariant& to, qreal progress ) const
+        {
+            return interpolated( from, to, progress );
+        }
+    };
+
+    class InterpolatorTable
+    {
+      public:
+        ~InterpolatorTable()
+        {
+            qDeleteAll( m_variantInterpolators );
+        }
+
+        void insert( int userType, QskVariantAnimator::Interpolator interpolator )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( interpolator )
+                m_interpolators.insert( userType, interpolator );
+            else
+                m_interpolators.remove( userType );
+        }
+
+        QskVariantAnimator::Interpolator interpolator( int userType ) const
+        {
+            QMutexLocker locker( &m_mutex );
+            return m_interpolators.value( userType, nullptr );
+        }
+
+        const VariantInterpolator* variantInterpolator(
+            const QVariant& from, const QVariant& to )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            const int userType = from.userType();
+
+            if ( m_variantInterpolators.contains( userType ) )
+                return m_variantInterpolators.value( userType );
+
+            auto interpolator = new VariantInterpolator( from, to );
+
+            if ( !interpolator->interpolate( from, to, 0.0 ).isValid() )
+            {
+                // no interpolator has been registered for this type
+                delete interpolator;
+                interpolator = nullptr;
+            }
+
+            m_variantInterpolators.insert( userType, interpolator );
+            return interpolator;
+        }
+
+      private:
+        mutable QMutex m_mutex;
+        QHash< int, QskVariantAnimator::Interpolator > m_interpolators;
+        QHash< int, VariantInterpolator* > m_variantInterpolators;
+    };
+}
+
+Q_GLOBAL_STATIC( InterpolatorTable, qskInterpolatorTable )
+
+template< typename T >
+static inline T qskInterpolated( const T& from, const T& to, qreal progress )
+{
+    // our own types
+    return from.interpolated( to, progress );
+}
+
+template< typename T >
+static inline T qskInterpolatedLinear( const T& from, const T& to, qreal progress )
+{
+    return T( from + ( to - from ) * progress );
+}
+
+template<>
+inline int qskInterpolated( const int& from, const int& to, qreal progress )
+{
+    return qskInterpolatedLinear( from, to, progress );
+}
+
+template<>
+inline uint qskInterpolated( const uint& from, const uint& to, qreal progress )
+{
+    // the difference might be negative
+    return uint( from + qRound( ( qreal( to ) - qreal( from ) ) * progress ) );
+}
+
+template<>
+inline float qskInterpolated( const float& from, const float& to, qreal progress )
+{
+    return qskInterpolatedLinear( from, to, progress );
+}
+
+template<>
+inline double qskInterpolated( const double& from, const double& to, qreal progress )
+{
+    return qskInterpolatedLinear( from, to, progress );
+}
+
+template<>
+inline QPoint qskInterpolated( const QPoint& from, const QPoint& to, qreal progress )
+{
+    return qskInterpolatedLinear( from, to, progress );
+}
+
+template<>
+inline QPointF qskInterpolated( const QPointF& from, const QPointF& to, qreal progress )
+{
+    return qskInterpolatedLinear( from, to, progress );
+}
+
+template<>
+inline QSize qskInterpolated( const QSize& from, const QSize& to, qreal progress )
+{
+    return qskInterpolatedLinear( from, to, progress );
+}
+
+template<>
+inline QSizeF qskInterpolated( const QSizeF& from, const QSizeF& to, qreal progress )
+{
+    return qskInterpolatedLinear( from, to, progress );
+}
+
+template<>
+inline QRect qskInterpolated( const QRect& from, const QRect& to, qreal progress )
+{
+    return QRect( qskInterpolated( from.topLeft(), to.topLeft(), progress ),
+        qskInterpolated( from.size(), to.size(), progress ) );
+}
 
-    auto f = reinterpret_cast< QVariantAnimation::Interpolator >( interpolator );
-    return f( from.constData(), to.constData(), progress );
+template<>
+inline QRectF qskInterpolated( const QRectF& from, const QRectF& to, qreal progress )
+{
+    return QRectF( qskInterpolated( from.topLeft(), to.topLeft(), progress ),
+        qskInterpolated( from.size(), to.size(), progress ) );
+}
+
+template<>
+inline QLine qskInterpolated( const QLine& from, const QLine& to, qreal progress )
+{
+    return QLine( qskInterpolated( from.p1(), to.p1(), progress ),
+        qskInterpolated( from.p2(), to.p2(), progress ) );
+}
+
+template<>
+inline QLineF qskInterpolated( const QLineF& from, const QLineF& to, qreal progress )
+{
+    return QLineF( qskInterpolated( from.p1(), to.p1(), progress ),
+        qskInterpolated( from.p2(), to.p2(), progress ) );
+}
+
+template<>
+inline QColor qskInterpolated( const QColor& from, const QColor& to, qreal progress )
+{
+    return QskRgbValue::interpolated( from, to, progress );
+}
+
+template<>
+inline QVector2D qskInterpolated(
+    const QVector2D& from, const QVector2D& to, qreal progress )
+{
+    return qskInterpolatedLinear( from, to, float( progress ) );
+}
+
+template<>
+inline QVector3D qskInterpolated(
+    const QVector3D& from, const QVector3D& to, qreal progress )
+{
+    return qskInterpolatedLinear( from, to, float( progress ) );
+}
+
+template<>
+inline QVector4D qskInterpolated(
+    const QVector4D& from, const QVector4D& to, qreal progress )
+{
+    return qskInterpolatedLinear( from, to, float( progress ) );
+}
+
+template<>
+inline QQuaternion qskInterpolated(
+    const QQuaternion& from, const QQuaternion& to, qreal progress )
+{
+    // like QVariantAnimation
+    return QQuaternion::slerp( from, to, float( progress ) );
+}
+
+/*
+    Writing into the current value avoids creating a new QVariant -
+    and for most types a heap allocation - for each frame.
+ */
+template< typename T >
+static void qskInterpolate( const void* from,
+    const void* to, qreal progress, void* value )
+{
+    *static_cast< T* >( value ) = qskInterpolated(
+        *static_cast< const T* >( from ), *static_cast< const T* >( to ), progress );
+}
+
+template< typename T >
+static inline bool qskIsType( int type )
+{
+    return type == qMetaTypeId< T >();
 }
 
 QskVariantAnimator::QskVariantAnimator()
     : m_interpolator( nullptr )
+    , m_variantInterpolator( nullptr )
 {
 }
 
@@ -84,19 +290,133 @@ void QskVariantAnimator::setCurrentValue( const QVariant& value )
     m_currentValue = value;
 }
 
+void QskVariantAnimator::registerInterpolator(
+    int userType, Interpolator interpolator )
+{
+    if ( auto table = qskInterpolatorTable )
+        table->insert( userType, interpolator );
+}
+
 void QskVariantAnimator::setup()
 {
     m_interpolator = nullptr;
+    m_variantInterpolator = nullptr;
 
     const auto type = m_startValue.userType();
     if ( type == m_endValue.userType() )
     {
-        // all what has been registered by qRegisterAnimationInterpolator
-        m_interpolator = reinterpret_cast< void ( * )() >(
-            QVariantAnimationPrivate::getInterpolator( type ) );
+        switch ( type )
+        {
+            case QMetaType::Int:
+                m_interpolator = qskInterpolate< int >;
+                break;
+
+            case QMetaType::UInt:
+                m_interpolator = qskInterpolate< uint >;
+                break;
+
+            case QMetaType::Float:
+                m_interpolator = qskInterpolate< float >;
+                break;
+
+            case QMetaType::Double:
+                m_interpolator = qskInterpolate< double >;
+                break;
+
+            case QMetaType::QColor:
+                m_interpolator = qskInterpolate< QColor >;
+                break;
+
+            case QMetaType::QPoint:
+                m_interpolator = qskInterpolate< QPoint >;
+                break;
+
+            case QMetaType::QPointF:
+                m_interpolator = qskInterpolate< QPointF >;
+                break;
+
+            case QMetaType::QSize:
+                m_interpolator = qskInterpolate< QSize >;
+                break;
+
+            case QMetaType::QSizeF:
+                m_interpolator = qskInterpolate< QSizeF >;
+                break;
+
+            case QMetaType::QRect:
+                m_interpolator = qskInterpolate< QRect >;
+                break;
+
+            case QMetaType::QRectF:
+                m_interpolator = qskInterpolate< QRectF >;
+                break;
+
+            case QMetaType::QLine:
+                m_interpolator = qskInterpolate< QLine >;
+                break;
+
+            case QMetaType::QLineF:
+                m_interpolator = qskInterpolate< QLineF >;
+                break;
+
+            case QMetaType::QVector2D:
+                m_interpolator = qskInterpolate< QVector2D >;
+                break;
+
+            case QMetaType::QVector3D:
+                m_interpolator = qskInterpolate< QVector3D >;
+                break;
+
+            case QMetaType::QVector4D:
+                m_interpolator = qskInterpolate< QVector4D >;
+                break;
+
+            case QMetaType::QQuaternion:
+                m_interpolator = qskInterpolate< QQuaternion >;
+                break;
+
+            default:
+            {
+                if ( auto table = qskInterpolatorTable )
+                    m_interpolator = table->interpolator( type );
+
+                if ( m_interpolator )
+                    break;
+
+                if ( qskIsType< QskGradient >( type ) )
+                    m_interpolator = qskInterpolate< QskGradient >;
+                else if ( qskIsType< QskBoxBorderColors >( type ) )
+                    m_interpolator = qskInterpolate< QskBoxBorderColors >;
+                else if ( qskIsType< QskBoxBorderMetrics >( type ) )
+                    m_interpolator = qskInterpolate< QskBoxBorderMetrics >;
+                else if ( qskIsType< QskBoxShapeMetrics >( type ) )
+                    m_interpolator = qskInterpolate< QskBoxShapeMetrics >;
+                else if ( qskIsType< QskMargins >( type ) )
+                    m_interpolator = qskInterpolate< QskMargins >;
+                else if ( qskIsType< QskTextColors >( type ) )
+                    m_interpolator = qskInterpolate< QskTextColors >;
+                else if ( qskIsType< QskColorFilter >( type ) )
+                    m_interpolator = qskInterpolate< QskColorFilter >;
+
+                if ( m_interpolator == nullptr )
+                {
+                    /*
+                        Types, that have been registered by
+                        qRegisterAnimationInterpolator. The result is a new
+                        QVariant for each frame, but better than no animation.
+                     */
+                    if ( auto table = qskInterpolatorTable )
+                    {
+                        m_variantInterpolator =
+                            table->variantInterpolator( m_startValue, m_endValue );
+                    }
+                }
+            }
+        }
     }
 
-    m_currentValue = m_interpolator ? m_startValue : m_endValue;
+    const bool canInterpolate = m_interpolator || m_variantInterpolator;
+    m_currentValue = canInterpolate ? m_startValue : m_endValue;
 }
 
 void QskVariantAnimator::advance( qreal progress )
@@ -106,7 +426,25 @@ void QskVariantAnimator::advance( qreal progress )
         if ( qFuzzyCompare( progress, 1.0 ) )
             progress = 1.0;
 
-        m_currentValue = qskInterpolate( m_interpolator,
+        if ( m_currentValue.userType() != m_startValue.userType() )
+            m_currentValue = m_startValue;
+
+        /*
+            data() detaches the current value once, after that
+            it is updated in place
+         */
+        m_interpolator( m_startValue.constData(),
+            m_endValue.constData(), progress, m_currentValue.data() );
+    }
+    else if ( m_variantInterpolator )
+    {
+        if ( qFuzzyCompare( progress, 1.0 ) )
+            progress = 1.0;
+
+        auto interpolator =
+            static_cast< const VariantInterpolator* >( m_variantInterpolator );
+
+        m_currentValue = interpolator->interpolate(
             m_startValue, m_endValue, progress );
     }
 }
@@ -114,4 +452,5 @@ void QskVariantAnimator::advance( qreal progress )
 void QskVariantAnimator::done()
 {
     m_interpolator = nullptr;
+    m_variantInterpolator = nullptr;
 }
@@ -9,6 +9,8 @@
 #include "QskAnimator.h"
 #include <qvariant.h>
 
+class QVariantAnimation;
+
 class QSK_EXPORT QskVariantAnimator : public QskAnimator
 {
   public:
@@ -24,6 +26,21 @@ class QSK_EXPORT QskVariantAnimator : public QskAnimator
     void setEndValue( const QVariant& );
     QVariant endValue() const;
 
+    /*
+        An interpolator writes the result into value, that is of the same
+        type as from/to. Registered interpolators are used for types, that
+        are not known to QskVariantAnimator. For all other types
+        the interpolators of QVariantAnimation are used.
+     */
+    typedef void ( *Interpolator )( const void* from,
+        const void* to, qreal progress, void* value );
+
+    static void registerInterpolator( int userType, Interpolator );
+
+    template< typename T >
+    static void registerInterpolator( void ( *interpolator )(
+        const T& from, const T& to, qreal progress, T& value ) );
+
   protected:
     void setup() override;
     void advance( qreal value ) override;
@@ -34,9 +51,21 @@ class QSK_EXPORT QskVariantAnimator : public QskAnimator
     QVariant m_endValue;
     QVariant m_currentValue;
 
-    void ( *m_interpolator )();
+    Interpolator m_interpolator;
+
+    // shared for all animators of the same type
+    const QVariantAnimation* m_variantInterpolator;
 };
 
+template< typename T >
+inline void QskVariantAnimator::registerInterpolator( void ( *interpolator )(
+    const T& from, const T& to, qreal progress, T& value ) )
+{
+    // the same trick as qRegisterAnimationInterpolator
+    registerInterpolator( qMetaTypeId< T >(),
+        reinterpret_cast< Interpolator >( interpolator ) );
+}
+
 inline QVariant QskVariantAnimator::startValue() const
 {
     return m_startValue;
@@ -0,0 +1,497 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskFlowBox.h"
+#include "QskLayoutConstraint.h"
+#include "QskLayoutEngine.h"
+#include "QskLayoutItem.h"
+#include "QskQuick.h"
+
+#include <qvector.h>
+
+#include <algorithm>
+#include <limits>
+
+/*
+    The position of an item in the flow is its index. The cells are only
+    needed by QGridLayoutEngine, that warns about items sharing a cell.
+    So the items get unique cells on a grid of a fixed width, what keeps
+    the number of rows/columns small.
+ */
+static const int qskSlotsPerRow = 64;
+
+namespace
+{
+    class Line
+    {
+      public:
+        int from; // index of the first item
+        int to;   // index behind the last item
+
+        qreal y;
+        qreal width; // preferred widths of the items + spacings
+        qreal height;
+    };
+
+    class Flow
+    {
+      public:
+        Flow( const QskLayoutEngine& engine, qreal width, qreal spacing )
+            : m_engine( engine )
+            , m_width( width )
+            , m_spacing( spacing )
+        {
+        }
+
+        // the size of an item, being shrunk to the width of a line
+        QSizeF itemSize( const QskLayoutItem* layoutItem, qreal& preferredWidth ) const
+        {
+            auto size = layoutItem->sizeHint( Qt::PreferredSize, QSizeF() );
+            preferredWidth = size.width();
+
+            if ( size.width() > m_width )
+            {
+                size.setWidth( m_width );
+
+                if ( layoutItem->hasDynamicConstraint() )
+                {
+                    const QSizeF constraint( m_width, -1.0 );
+                    size.setHeight( layoutItem->sizeHint(
+                        Qt::PreferredSize, constraint ).height() );
+                }
+            }
+
+            return size;
+        }
+
+        QSizeF itemSize( const QskLayoutItem* layoutItem ) const
+        {
+            qreal preferredWidth;
+            return itemSize( layoutItem, preferredWidth );
+        }
+
+        inline const QskLayoutItem* itemAt( int index ) const
+        {
+            const auto layoutItem = m_engine.layoutItemAt( index );
+            if ( layoutItem == nullptr || layoutItem->isIgnored() )
+                return nullptr;
+
+            return layoutItem;
+        }
+
+        // lines for all items from index on
+        void appendLines( int index, qreal y, QVector< Line >& lines ) const
+        {
+            const int count = m_engine.itemCount();
+
+            Line line { index, index, y, 0.0, 0.0 };
+            int lineItems = 0;
+
+            for ( int i = index; i < count; i++ )
+            {
+                if ( const auto layoutItem = itemAt( i ) )
+                {
+                    qreal preferredWidth;
+                    const auto size = itemSize( layoutItem, preferredWidth );
+
+                    if ( lineItems > 0 )
+                    {
+                        if ( line.width + m_spacing + size.width() > m_width )
+                        {
+                            lines += line;
+
+                            y += line.height + m_spacing;
+
+                            line = { i, i, y, 0.0, 0.0 };
+                            lineItems = 0;
+                        }
+                        else
+                        {
+                            line.width += m_spacing;
+                        }
+                    }
+
+                    line.width += preferredWidth;
+                    line.height = qMax( line.height, size.height() );
+
+                    lineItems++;
+                }
+
+                line.to = i + 1;
+            }
+
+            if ( line.to > line.from )
+                lines += line;
+        }
+
+        /*
+            A line remains the same, when none of its items had to be
+            shrunk and the first item of the following line does not fit
+         */
+        bool isStable( const QVector< Line >& lines, int lineIndex ) const
+        {
+            const auto& line = lines[ lineIndex ];
+
+            if ( line.width > m_width )
+                return false;
+
+            if ( lineIndex + 1 < lines.size() )
+            {
+                const auto& next = lines[ lineIndex + 1 ];
+
+                for ( int i = next.from; i < next.to; i++ )
+                {
+                    if ( const auto layoutItem = itemAt( i ) )
+                    {
+                        const auto w = itemSize( layoutItem ).width();
+                        return line.width + m_spacing + w > m_width;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        qreal height( const QVector< Line >& lines ) const
+        {
+            if ( lines.isEmpty() )
+                return 0.0;
+
+            const auto& line = lines.last();
+            return line.y + line.height;
+        }
+
+      private:
+        const QskLayoutEngine& m_engine;
+
+        const qreal m_width;
+        const qreal m_spacing;
+    };
+}
+
+class QskFlowBox::PrivateData
+{
+  public:
+    PrivateData()
+        : lineWidth( -1.0 )
+        , dirtyIndex( 0 )
+        , pendingRequests( 0 )
+        , slotCount( 0 )
+        , hintWidth( -1.0 )
+        , hintHeight( -1.0 )
+    {
+    }
+
+    QVector< Line > lines;
+
+    qreal lineWidth; // the width, the lines have been calculated for
+    int dirtyIndex;  // lines need to be recalculated from this item on
+
+    // layout requests, that have not been identified yet
+    int pendingRequests;
+
+    // the cells of the engine
+    int slotCount;
+    QVector< int > freeSlots;
+
+    // the last result of heightForWidth
+    mutable qreal hintWidth;
+    mutable qreal hintHeight;
+};
+
+QskFlowBox::QskFlowBox( QQuickItem* parent )
+    : Inherited( parent )
+    , m_data( new PrivateData() )
+{
+    setSizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Constrained );
+}
+
+QskFlowBox::~QskFlowBox()
+{
+}
+
+void QskFlowBox::setSpacing( qreal spacing )
+{
+    spacing = qMax( spacing, 0.0 );
+
+    if ( spacing != engine().spacing( Qt::Horizontal ) )
+    {
+        engine().setSpacing( spacing, Qt::Horizontal | Qt::Vertical );
+
+        invalidateLines( 0 );
+        activate();
+
+        Q_EMIT spacingChanged();
+    }
+}
+
+void QskFlowBox::resetSpacing()
+{
+    setSpacing( QskLayoutEngine::defaultSpacing( Qt::Horizontal ) );
+}
+
+qreal QskFlowBox::spacing() const
+{
+    return engine().spacing( Qt::Horizontal );
+}
+
+int QskFlowBox::lineCount() const
+{
+    return m_data->lines.count();
+}
+
+void QskFlowBox::invalidateFlow()
+{
+    invalidateLines( 0 );
+    invalidate();
+}
+
+void QskFlowBox::invalidateLines( int index )
+{
+    m_data->dirtyIndex = qMin( m_data->dirtyIndex, index );
+    m_data->hintWidth = -1.0;
+}
+
+void QskFlowBox::updateLines( qreal width )
+{
+    const Flow flow( engine(), width, spacing() );
+
+    auto& lines = m_data->lines;
+
+    if ( width != m_data->lineWidth )
+    {
+        /*
+            Lines, that had to shrink an item before, might have
+            a different height now
+         */
+        int lineIndex = 0;
+        while ( lineIndex < lines.size()
+            && lines[ lineIndex ].width <= m_data->lineWidth
+            && flow.isStable( lines, lineIndex ) )
+        {
+            lineIndex++;
+        }
+
+        if ( lineIndex < lines.size() )
+            invalidateLines( lines[ lineIndex ].from );
+
+        m_data->lineWidth = width;
+    }
+
+    const int count = engine().itemCount();
+    if ( m_data->dirtyIndex >= count && !lines.isEmpty() && lines.last().to == count )
+        return;
+
+    /*
+        A modification of the first item of a line might allow it to
+        be moved to the previous one. So we start one line earlier.
+     */
+
+    auto it = std::upper_bound( lines.begin(), lines.end(), m_data->dirtyIndex,
+        []( int index, const Line& line ) { return index < line.from; } );
+
+    int lineIndex = int( it - lines.begin() ) - 2;
+    lineIndex = qMax( lineIndex, 0 );
+
+    int from = 0;
+    qreal y = 0.0;
+
+    if ( lineIndex < lines.size() )
+    {
+        from = lines[ lineIndex ].from;
+        y = lines[ lineIndex ].y;
+    }
+
+    lines.resize( lineIndex );
+    flow.appendLines( from, y, lines );
+
+    m_data->dirtyIndex = std::numeric_limits< int >::max();
+}
+
+void QskFlowBox::setItemGeometries( const QRectF& rect )
+{
+    updateLines( rect.width() );
+
+    const Flow flow( engine(), rect.width(), spacing() );
+    const qreal spacing = this->spacing();
+    const bool mirrored = layoutMirroring();
+
+    for ( const auto& line : qAsConst( m_data->lines ) )
+    {
+        qreal x = 0.0;
+
+        for ( int i = line.from; i < line.to; i++ )
+        {
+            auto layoutItem = engine().layoutItemAt( i );
+            if ( layoutItem == nullptr || layoutItem->isIgnored() )
+                continue;
+
+            const auto size = flow.itemSize( layoutItem );
+
+            qreal y = line.y;
+
+            const auto alignment = layoutItem->alignment();
+            if ( alignment & Qt::AlignVCenter )
+                y += 0.5 * ( line.height - size.height() );
+            else if ( alignment & Qt::AlignBottom )
+                y += line.height - size.height();
+
+            QRectF r( rect.x() + x, rect.y() + y, size.width(), size.height() );
+            if ( mirrored )
+                r.moveRight( rect.right() - x );
+
+            layoutItem->setGeometry( r );
+
+            x += size.width() + spacing;
+        }
+    }
+}
+
+QSizeF QskFlowBox::layoutItemsSizeHint() const
+{
+    // all items in one line
+
+    const qreal unlimited = std::numeric_limits< qreal >::max();
+    const Flow flow( engine(), unlimited, spacing() );
+
+    QVector< Line > lines;
+    flow.appendLines( 0, 0.0, lines );
+
+    if ( lines.isEmpty() )
+        return QSizeF( 0.0, 0.0 );
+
+    return QSizeF( lines[ 0 ].width, lines[ 0 ].height );
+}
+
+qreal QskFlowBox::heightForWidth( qreal width ) const
+{
+    auto constrainedHeight =
+        [this]( QskLayoutConstraint::Type, const QskControl*, qreal width )
+    {
+        const Flow flow( engine(), width, spacing() );
+
+        if ( width == m_data->lineWidth )
+        {
+            // usually the width of the last layout pass: updating incrementally
+            const_cast< QskFlowBox* >( this )->updateLines( width );
+            return flow.height( m_data->lines );
+        }
+
+        if ( width != m_data->hintWidth )
+        {
+            QVector< Line > lines;
+            flow.appendLines( 0, 0.0, lines );
+
+            m_data->hintWidth = width;
+            m_data->hintHeight = flow.height( lines );
+        }
+
+        return m_data->hintHeight;
+    };
+
+    return QskLayoutConstraint::constrainedMetric(
+        QskLayoutConstraint::HeightForWidth, this, width, constrainedHeight );
+}
+
+qreal QskFlowBox::widthForHeight( qreal height ) const
+{
+    Q_UNUSED( height )
+    return -1.0;
+}
+
+bool QskFlowBox::event( QEvent* event )
+{
+    if ( event->type() == QEvent::LayoutRequest )
+    {
+        if ( isActive() && isVisible() && window() )
+        {
+            /*
+                The request does not tell us which item has been changed.
+                As a control sends it right before emitting visibleChanged,
+                we postpone it to the polish cycle, so that
+                itemVisibilityChanged can find the item.
+             */
+            m_data->pendingRequests++;
+            activate();
+
+            return true;
+        }
+
+        invalidateLines( 0 );
+    }
+
+    return Inherited::event( event );
+}
+
+void QskFlowBox::updateLayout()
+{
+    if ( m_data->pendingRequests > 0 )
+    {
+        // requests, that were not caused by showing/hiding an item
+
+        m_data->pendingRequests = 0;
+
+        engine().invalidateSizeHints();
+        invalidateFlow();
+    }
+
+    Inherited::updateLayout();
+}
+
+void QskFlowBox::itemVisibilityChanged()
+{
+    const auto item = qobject_cast< const QQuickItem* >( sender() );
+
+    const int index = indexOf( item );
+    if ( index < 0 )
+        return;
+
+    // a control has sent a layout request before
+    if ( qskControlCast( item ) && m_data->pendingRequests > 0 )
+        m_data->pendingRequests--;
+
+    invalidateLines( index );
+    invalidate();
+}
+
+void QskFlowBox::setupLayoutItem( QskLayoutItem* layoutItem, int index )
+{
+    Inherited::setupLayoutItem( layoutItem, index );
+
+    int slot;
+
+    if ( !m_data->freeSlots.isEmpty() )
+        slot = m_data->freeSlots.takeLast();
+    else
+        slot = m_data->slotCount++;
+
+    layoutItem->setFirstRow( slot / qskSlotsPerRow, Qt::Vertical );
+    layoutItem->setFirstRow( slot % qskSlotsPerRow, Qt::Horizontal );
+}
+
+void QskFlowBox::layoutItemInserted( QskLayoutItem* layoutItem, int index )
+{
+    Inherited::layoutItemInserted( layoutItem, index );
+
+    invalidateLines( index );
+
+    if ( auto item = layoutItem->item() )
+        connect( item, &QQuickItem::visibleChanged, this, &QskFlowBox::itemVisibilityChanged );
+}
+
+void QskFlowBox::layoutItemRemoved( QskLayoutItem* layoutItem, int index )
+{
+    Inherited::layoutItemRemoved( layoutItem, index );
+
+    invalidateLines( index );
+
+    m_data->freeSlots += layoutItem->firstRow( Qt::Vertical ) * qskSlotsPerRow
+        + layoutItem->firstRow( Qt::Horizontal );
+
+    if ( auto item = layoutItem->item() )
+        disconnect( item, &QQuickItem::visibleChanged, this, &QskFlowBox::itemVisibilityChanged );
+}
+
+#include "moc_QskFlowBox.cpp"
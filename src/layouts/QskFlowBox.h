@@ -0,0 +1,65 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_FLOW_BOX_H
+#define QSK_FLOW_BOX_H
+
+#include "QskIndexedLayoutBox.h"
+
+/*
+    QskFlowBox arranges its items with their preferred sizes from left
+    to right, starting a new line when the next item does not fit.
+
+    The lines are kept between the layout passes, so that inserting,
+    removing or resizing only has to recalculate the lines from
+    the first one, that is affected.
+ */
+class QSK_EXPORT QskFlowBox : public QskIndexedLayoutBox
+{
+    Q_OBJECT
+
+    Q_PROPERTY( qreal spacing READ spacing
+        WRITE setSpacing RESET resetSpacing NOTIFY spacingChanged )
+
+    using Inherited = QskIndexedLayoutBox;
+
+  public:
+    explicit QskFlowBox( QQuickItem* parent = nullptr );
+    ~QskFlowBox() override;
+
+    void setSpacing( qreal spacing );
+    void resetSpacing();
+    qreal spacing() const;
+
+    Q_INVOKABLE int lineCount() const;
+
+    qreal heightForWidth( qreal width ) const override;
+    qreal widthForHeight( qreal height ) const override;
+
+  Q_SIGNALS:
+    void spacingChanged();
+
+  protected:
+    bool event( QEvent* ) override;
+    void updateLayout() override;
+
+    void setItemGeometries( const QRectF& ) override;
+    QSizeF layoutItemsSizeHint() const override;
+
+    void setupLayoutItem( QskLayoutItem*, int index ) override;
+    void layoutItemInserted( QskLayoutItem*, int index ) override;
+    void layoutItemRemoved( QskLayoutItem*, int index ) override;
+
+  private:
+    void itemVisibilityChanged();
+    void invalidateFlow();
+    void invalidateLines( int index );
+    void updateLines( qreal width );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -12,12 +12,22 @@ class QskGridBox::PrivateData
   public:
     PrivateData()
         : isExpanding( false )
+        , isStatic( false )
         , unlimitedSpanned( 0 )
+        , pendingRequests( 0 )
     {
     }
 
-    bool isExpanding;
+    bool isExpanding : 1;
+    bool isStatic : 1;
+
     unsigned int unlimitedSpanned;
+
+    /*
+        Layout requests of a static grid, that have not been
+        identified as being sent because of a child being shown/hidden.
+     */
+    unsigned int pendingRequests;
 };
 
 QskGridBox::QskGridBox( QQuickItem* parent )
@@ -112,12 +122,21 @@ void QskGridBox::setupLayoutItem( QskLayoutItem* layoutItem, int index )
 
     m_data->isExpanding = ( layoutItem->lastColumn() >= engine.columnCount() ) ||
         ( layoutItem->lastRow() >= engine.rowCount() );
+
+    if ( m_data->isStatic )
+        layoutItem->setRetainSizeWhenHidden( true );
 }
 
 void QskGridBox::layoutItemInserted( QskLayoutItem* layoutItem, int index )
 {
     Q_UNUSED( index )
 
+    if ( auto item = layoutItem->item() )
+    {
+        connect( item, &QQuickItem::visibleChanged,
+            this, &QskGridBox::childVisibilityChanged );
+    }
+
     if ( m_data->isExpanding )
     {
         // the new item has extended the number of rows/columns and
@@ -151,6 +170,12 @@ void QskGridBox::layoutItemRemoved( QskLayoutItem* layoutItem, int index )
 {
     Q_UNUSED( index )
 
+    if ( auto item = layoutItem->item() )
+    {
+        disconnect( item, &QQuickItem::visibleChanged,
+            this, &QskGridBox::childVisibilityChanged );
+    }
+
     if ( layoutItem->hasUnlimitedSpan() )
         m_data->unlimitedSpanned--;
 
@@ -435,4 +460,84 @@ void QskGridBox::setRowSizeHint(
     }
 }
 
+void QskGridBox::setStaticGrid( bool on )
+{
+    if ( on == m_data->isStatic )
+        return;
+
+    m_data->isStatic = on;
+    m_data->pendingRequests = 0;
+
+    const auto& engine = this->engine();
+
+    for ( int i = 0; i < engine.itemCount(); i++ )
+        engine.layoutItemAt( i )->setRetainSizeWhenHidden( on );
+
+    invalidate();
+
+    Q_EMIT staticGridChanged();
+}
+
+bool QskGridBox::isStaticGrid() const
+{
+    return m_data->isStatic;
+}
+
+void QskGridBox::childVisibilityChanged()
+{
+    if ( !m_data->isStatic || m_data->pendingRequests == 0 || !isVisible() )
+        return;
+
+    /*
+        A control sends a layout request to its visible parent, right before
+        emitting visibleChanged. When the item keeps its cell, this request
+        does not affect the rows/columns and can be dropped.
+     */
+
+    const auto item = qobject_cast< const QQuickItem* >( sender() );
+    if ( qskControlCast( item ) == nullptr )
+        return;
+
+    const auto layoutItem = engine().layoutItemOf( item );
+    if ( layoutItem && layoutItem->retainSizeWhenHidden() )
+        m_data->pendingRequests--;
+}
+
+void QskGridBox::updateLayout()
+{
+    if ( m_data->pendingRequests > 0 )
+    {
+        // requests, that were not caused by showing/hiding an item
+
+        m_data->pendingRequests = 0;
+
+        engine().invalidateSizeHints();
+        invalidate();
+    }
+
+    Inherited::updateLayout();
+}
+
+bool QskGridBox::event( QEvent* event )
+{
+    if ( event->type() == QEvent::LayoutRequest )
+    {
+        if ( m_data->isStatic && isActive() && isVisible() && window() )
+        {
+            /*
+                At this point we can't decide if the request has been sent
+                because of an item being shown/hidden. So the request is
+                postponed to the polish cycle and might be dropped
+                in childVisibilityChanged.
+             */
+            m_data->pendingRequests++;
+            activate();
+
+            return true;
+        }
+    }
+
+    return Inherited::event( event );
+}
+
 #include "moc_QskGridBox.cpp"
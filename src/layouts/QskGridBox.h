@@ -20,6 +20,9 @@ class QSK_EXPORT QskGridBox : public QskLayoutBox
         WRITE setVerticalSpacing RESET resetVerticalSpacing
         NOTIFY verticalSpacingChanged )
 
+    Q_PROPERTY( bool staticGrid READ isStaticGrid
+        WRITE setStaticGrid NOTIFY staticGridChanged )
+
     using Inherited = QskLayoutBox;
 
   public:
@@ -113,16 +116,34 @@ class QSK_EXPORT QskGridBox : public QskLayoutBox
     Q_INVOKABLE bool retainSizeWhenHidden( QQuickItem* ) const;
     Q_INVOKABLE void setRetainSizeWhenHidden( QQuickItem*, bool on );
 
+    /*
+        In a static grid all cells are reserved, even when the items
+        are hidden. Then showing/hiding items does not need to
+        recalculate the rows and columns.
+
+        Enabling/disabling the static mode sets the
+        retainSizeWhenHidden flag of all items. Items, where the flag
+        is reset afterwards, update the grid when being shown/hidden.
+     */
+    void setStaticGrid( bool on );
+    bool isStaticGrid() const;
+
   Q_SIGNALS:
     void verticalSpacingChanged();
     void horizontalSpacingChanged();
+    void staticGridChanged();
 
   protected:
+    bool event( QEvent* ) override;
+    void updateLayout() override;
+
     void setupLayoutItem( QskLayoutItem*, int index ) override;
     void layoutItemInserted( QskLayoutItem*, int index ) override;
     void layoutItemRemoved( QskLayoutItem*, int index ) override;
 
   private:
+    void childVisibilityChanged();
+
     void setRowSizeHint(
         Qt::SizeHint which, int row, qreal size,
         Qt::Orientation orientation );
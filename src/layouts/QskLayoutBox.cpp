@@ -8,16 +8,106 @@
 #include "QskLayoutEngine.h"
 #include "QskLayoutItem.h"
 #include "QskLayoutConstraint.h"
+#include "QskLayoutProfiler.h"
+#include "QskTextLabel.h"
+#include "QskTextOptions.h"
+#include "QskTextRenderer.h"
+
+#include <qrunnable.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#include <qvector.h>
+
+namespace
+{
+    class TextInfo
+    {
+      public:
+        QString text;
+        QFont font;
+        QskTextOptions options;
+    };
+
+    class TextSizeJob final : public QRunnable
+    {
+      public:
+        TextSizeJob( const QVector< TextInfo >& infos, int from, int to )
+            : m_infos( infos )
+            , m_from( from )
+            , m_to( to )
+        {
+        }
+
+        void run() override
+        {
+            /*
+                The results are not needed here: measuring plain texts
+                is thread safe and QskTextRenderer remembers the sizes.
+             */
+            for ( int i = m_from; i < m_to; i++ )
+            {
+                const auto& info = m_infos[ i ];
+                ( void ) QskTextRenderer::textSize( info.text, info.font, info.options );
+            }
+        }
+
+      private:
+        const QVector< TextInfo >& m_infos;
+
+        const int m_from;
+        const int m_to;
+    };
+}
+
+static void qskCollectTextInfos( const QQuickItem* item,
+    QVector< TextInfo >& infos, QVector< QskControl* >& controls,
+    QVector< QskLayoutBox* >& boxes )
+{
+    const auto children = item->childItems();
+    for ( auto child : children )
+    {
+        if ( auto label = qobject_cast< QskTextLabel* >( child ) )
+        {
+            const auto text = label->text();
+            const auto options = label->textOptions();
+
+            // rich texts are laid out by QTextDocument, what we don't do in parallel
+            if ( !text.isEmpty() &&
+                options.effectiveFormat( text ) == QskTextOptions::PlainText )
+            {
+                auto effectiveOptions = options;
+                effectiveOptions.setFormat( QskTextOptions::PlainText );
+
+                infos += TextInfo { text,
+                    label->effectiveFont( QskTextLabel::Text ), effectiveOptions };
+                controls += label;
+            }
+        }
+        else if ( auto box = qobject_cast< QskLayoutBox* >( child ) )
+        {
+            boxes += box;
+        }
+
+        qskCollectTextInfos( child, infos, controls, boxes );
+    }
+}
 
 class QskLayoutBox::PrivateData
 {
   public:
     PrivateData()
-        : isActive( true )
+        : updateCount( 0 )
+        , isActive( true )
+        , isInvalidated( false )
+        , hasPendingPropagation( false )
     {
     }
 
+    int updateCount;
+
     bool isActive : 1;
+    bool isInvalidated : 1;
+    bool hasPendingPropagation : 1;
 
     QskLayoutEngine engine;
 };
@@ -133,9 +223,7 @@ void QskLayoutBox::insertItemInternal( QskLayoutItem* layoutItem, int index )
     if ( m_data->isActive )
     {
         setItemActive( item, true );
-
-        resetImplicitSize();
-        polish();
+        invalidate();
     }
 }
 
@@ -148,17 +236,14 @@ void QskLayoutBox::removeAt( int index )
         return;
 
     setItemActive( layoutItem->item(), false );
-    engine.removeItem( layoutItem );
+    engine.removeLayoutItem( layoutItem );
 
     layoutItemRemoved( layoutItem, index );
 
     delete layoutItem;
 
     if ( m_data->isActive )
-    {
-        resetImplicitSize();
-        polish();
-    }
+        invalidate();
 }
 
 void QskLayoutBox::removeItem( QQuickItem* item )
@@ -216,11 +301,137 @@ void QskLayoutBox::activate()
 void QskLayoutBox::invalidate()
 {
     engine().invalidate();
+
+    if ( m_data->updateCount > 0 )
+    {
+        // postponed until endUpdate
+        m_data->isInvalidated = true;
+        return;
+    }
+
+    QSK_LAYOUT_PROFILE( this, Invalidation );
+
     activate();
+    propagate();
+}
 
+void QskLayoutBox::propagate()
+{
+    QSK_LAYOUT_PROFILE( this, Propagation );
+
+    m_data->hasPendingPropagation = false;
     resetImplicitSize();
 }
 
+void QskLayoutBox::beginUpdate()
+{
+    m_data->updateCount++;
+}
+
+void QskLayoutBox::endUpdate()
+{
+    if ( m_data->updateCount == 0 )
+        return;
+
+    if ( --m_data->updateCount > 0 || !m_data->isInvalidated )
+        return;
+
+    m_data->isInvalidated = false;
+
+    QSK_LAYOUT_PROFILE( this, Invalidation );
+
+    if ( m_data->isActive && isVisible() && window() )
+    {
+        /*
+            Notifying the parent is deferred to the next polish cycle,
+            so that the updates of nested boxes in the same frame
+            are propagated only once.
+         */
+        m_data->hasPendingPropagation = true;
+        polish();
+    }
+    else
+    {
+        // hidden boxes are not polished
+        propagate();
+    }
+}
+
+bool QskLayoutBox::isUpdating() const
+{
+    return m_data->updateCount > 0;
+}
+
+void QskLayoutBox::precalculateSizeHints()
+{
+    QVector< TextInfo > infos;
+    QVector< QskControl* > controls;
+    QVector< QskLayoutBox* > boxes;
+
+    qskCollectTextInfos( this, infos, controls, boxes );
+
+    if ( infos.isEmpty() )
+        return;
+
+    const int minChunkSize = 50;
+    const int threadCount = qMin( QThread::idealThreadCount(),
+        infos.size() / minChunkSize );
+
+    if ( threadCount > 1 )
+    {
+        QThreadPool pool;
+        pool.setMaxThreadCount( threadCount );
+
+        const int chunkSize = ( infos.size() + threadCount - 1 ) / threadCount;
+
+        for ( int from = 0; from < infos.size(); from += chunkSize )
+        {
+            const int to = qMin( from + chunkSize, infos.size() );
+            pool.start( new TextSizeJob( infos, from, to ) );
+        }
+
+        pool.waitForDone();
+    }
+    else
+    {
+        TextSizeJob job( infos, 0, infos.size() );
+        job.run();
+    }
+
+    /*
+        Controls in DeferredLayout mode calculate their implicit
+        size, when being asked for it, finding the texts being measured.
+        All others need to be updated, what is done in one batch.
+     */
+
+    boxes += this;
+
+    for ( auto box : qAsConst( boxes ) )
+        box->beginUpdate();
+
+    for ( auto control : qAsConst( controls ) )
+    {
+        if ( !control->testControlFlag( QskControl::DeferredLayout ) )
+            control->resetImplicitSize();
+    }
+
+    for ( auto box : qAsConst( boxes ) )
+        box->endUpdate();
+}
+
+void QskLayoutBox::invalidateItem()
+{
+    // the implicit size of an item, that is not a QskControl, has changed
+
+    if ( auto item = qobject_cast< const QQuickItem* >( sender() ) )
+    {
+        if ( auto layoutItem = engine().layoutItemOf( item ) )
+            layoutItem->invalidateSizeHints();
+    }
+
+    invalidate();
+}
+
 void QskLayoutBox::adjustItem( const QQuickItem* item )
 {
     adjustItemAt( indexOf( item ) );
@@ -232,16 +443,31 @@ void QskLayoutBox::adjustItemAt( int index )
     if ( layoutItem == nullptr )
         return;
 
+    QSK_LAYOUT_PROFILE( this, Geometries );
+
     // setting UpdateNone to all others ???
     layoutItem->setUpdateMode( QskLayoutItem::UpdateAlways );
-    engine().setGeometries( alignedLayoutRect( layoutRect() ) );
+    setItemGeometries( alignedLayoutRect( layoutRect() ) );
     layoutItem->setUpdateMode( QskLayoutItem::UpdateWhenVisible );
 }
 
 void QskLayoutBox::updateLayout()
 {
+    QSK_LAYOUT_PROFILE( this, Layout );
+
+    if ( m_data->hasPendingPropagation )
+        propagate();
+
     if ( m_data->isActive )
-        engine().setGeometries( alignedLayoutRect( layoutRect() ) );
+    {
+        QSK_LAYOUT_PROFILE( this, Geometries );
+        setItemGeometries( alignedLayoutRect( layoutRect() ) );
+    }
+}
+
+void QskLayoutBox::setItemGeometries( const QRectF& rect )
+{
+    engine().setGeometries( rect );
 }
 
 QRectF QskLayoutBox::alignedLayoutRect( const QRectF& rect ) const
@@ -310,18 +536,18 @@ void QskLayoutBox::setItemActive( const QQuickItem* item, bool on )
         if ( on )
         {
             connect( item, &QQuickItem::implicitWidthChanged,
-                this, &QskLayoutBox::invalidate );
+                this, &QskLayoutBox::invalidateItem );
 
             connect( item, &QQuickItem::implicitHeightChanged,
-                this, &QskLayoutBox::invalidate );
+                this, &QskLayoutBox::invalidateItem );
         }
         else
         {
             disconnect( item, &QQuickItem::implicitWidthChanged,
-                this, &QskLayoutBox::invalidate );
+                this, &QskLayoutBox::invalidateItem );
 
             disconnect( item, &QQuickItem::implicitHeightChanged,
-                this, &QskLayoutBox::invalidate );
+                this, &QskLayoutBox::invalidateItem );
         }
     }
 
@@ -356,12 +582,20 @@ void QskLayoutBox::itemChange( ItemChange change, const ItemChangeData& value )
         {
             if ( value.boolValue )
                 activate();
+            else if ( m_data->hasPendingPropagation )
+                propagate(); // there will be no polish cycle
             break;
         }
         case QQuickItem::ItemSceneChange:
         {
             if ( value.window )
+            {
                 activate();
+            }
+            else if ( m_data->hasPendingPropagation )
+            {
+                propagate();
+            }
             break;
         }
         default:
@@ -375,6 +609,11 @@ bool QskLayoutBox::event( QEvent* event )
     {
         case QEvent::LayoutRequest:
         {
+            /*
+                QskControl::layoutConstraintChanged does not tell us
+                which child has been changed, so all cached hints are lost.
+             */
+            engine().invalidateSizeHints();
             invalidate();
             break;
         }
@@ -36,6 +36,21 @@ class QSK_EXPORT QskLayoutBox : public QskControl
     Q_INVOKABLE void setActive( bool );
     Q_INVOKABLE bool isActive() const;
 
+    /*
+        Invalidations between beginUpdate and endUpdate are collected
+        and processed once. For visible boxes the parent is notified
+        in the following polish cycle.
+     */
+    void beginUpdate();
+    void endUpdate();
+    bool isUpdating() const;
+
+    /*
+        Measures the texts of all labels below the box in parallel.
+        Intended to be called before the box is shown for the first time.
+     */
+    void precalculateSizeHints();
+
     void adjustItem( const QQuickItem* );
     void adjustItemAt( int index );
 
@@ -66,10 +81,14 @@ class QSK_EXPORT QskLayoutBox : public QskControl
     virtual void layoutItemInserted( QskLayoutItem*, int index );
     virtual void layoutItemRemoved( QskLayoutItem*, int index );
 
+    virtual void setItemGeometries( const QRectF& );
     virtual QRectF alignedLayoutRect( const QRectF& ) const;
     virtual QSizeF layoutItemsSizeHint() const;
 
   private:
+    void invalidateItem();
+    void propagate();
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
@@ -0,0 +1,664 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskLayoutChain.h"
+#include "QskLayoutConstraint.h"
+
+#include <qmath.h>
+#include <qvarlengtharray.h>
+
+#include <algorithm>
+
+namespace
+{
+    enum CellFlag : unsigned char
+    {
+        // at least one item starts in this cell
+        Used = 1 << 0,
+
+        // no item and no user hints: the cell is collapsed
+        Ignored = 1 << 1,
+
+        // the stretch factor has been set for the row/column
+        UserStretch = 1 << 2,
+
+        // the size hints have been set for the row/column
+        UserHints = 1 << 3,
+
+        // all items starting in the cell have QLayoutPolicy::IgnoreFlag
+        IgnoreFlagOnly = 1 << 4
+    };
+}
+
+static inline qreal qskGrowthFactor(
+    qreal desired, qreal sumAvailable, qreal sumDesired )
+{
+    return desired * qPow( sumAvailable / sumDesired, desired / sumDesired );
+}
+
+QskLayoutChain::Hint::Hint()
+    : minimum( 0.0 )
+    , preferred( 0.0 )
+    , maximum( QskLayoutConstraint::unlimited )
+{
+}
+
+inline qreal QskLayoutChain::Hint::value( int which ) const
+{
+    switch ( which )
+    {
+        case Qt::MinimumSize:
+            return minimum;
+
+        case Qt::PreferredSize:
+            return preferred;
+
+        default:
+            return maximum;
+    }
+}
+
+inline qreal& QskLayoutChain::Hint::value( int which )
+{
+    switch ( which )
+    {
+        case Qt::MinimumSize:
+            return minimum;
+
+        case Qt::PreferredSize:
+            return preferred;
+
+        default:
+            return maximum;
+    }
+}
+
+QskLayoutChain::QskLayoutChain()
+    : m_count( 0 )
+    , m_hasIgnoreFlag( false )
+{
+}
+
+QskLayoutChain::~QskLayoutChain()
+{
+}
+
+void QskLayoutChain::reset( int count )
+{
+    m_count = qMax( count, 0 );
+    m_hasIgnoreFlag = false;
+
+    m_minimum.assign( m_count, 0.0 );
+    m_preferred.assign( m_count, 0.0 );
+    m_maximum.assign( m_count, QskLayoutConstraint::unlimited );
+    m_spacing.assign( m_count, 0.0 );
+    m_stretch.assign( m_count, -1 );
+    m_flags.assign( m_count, IgnoreFlagOnly );
+
+    m_userHints.assign( m_count, Hint() );
+    m_spannedCells.clear();
+
+    m_boundary = Hint();
+}
+
+void QskLayoutChain::setSpacing( int index, qreal spacing )
+{
+    m_spacing[ index ] = qMax( spacing, 0.0 );
+}
+
+void QskLayoutChain::setUserHints( int index, int stretch,
+    qreal minimum, qreal preferred, qreal maximum )
+{
+    if ( stretch > 0 )
+    {
+        m_stretch[ index ] = stretch;
+        m_flags[ index ] |= UserStretch;
+    }
+
+    if ( minimum > 0.0 || preferred > 0.0
+        || maximum < QskLayoutConstraint::unlimited )
+    {
+        auto& hint = m_userHints[ index ];
+
+        hint.minimum = qMax( minimum, 0.0 );
+        hint.maximum = qMax( maximum, hint.minimum );
+        hint.preferred = qBound( hint.minimum, preferred, hint.maximum );
+
+        m_flags[ index ] |= UserHints;
+    }
+}
+
+void QskLayoutChain::addCell( int index, int span, int stretch,
+    qreal minimum, qreal preferred, qreal maximum, bool ignoreFlag )
+{
+    if ( index < 0 || index >= m_count )
+        return;
+
+    span = qBound( 1, span, m_count - index );
+
+    auto& flags = m_flags[ index ];
+
+    flags |= Used;
+    if ( !ignoreFlag )
+        flags &= ~IgnoreFlagOnly;
+
+    Hint hint;
+    hint.minimum = minimum;
+    hint.preferred = preferred;
+    hint.maximum = maximum;
+
+    if ( span == 1 )
+    {
+        combine( index, hint );
+
+        if ( !( flags & UserStretch ) && stretch != 0 )
+            m_stretch[ index ] = qMax( m_stretch[ index ], stretch );
+    }
+    else
+    {
+        m_spannedCells.push_back( { index, span, stretch, hint } );
+    }
+}
+
+void QskLayoutChain::finish()
+{
+    for ( int i = 0; i < m_count; i++ )
+    {
+        auto& flags = m_flags[ i ];
+
+        if ( flags & UserHints )
+        {
+            // the hints of the row/column win over those of the items
+
+            const auto& hint = m_userHints[ i ];
+
+            auto& minimum = m_minimum[ i ];
+            auto& maximum = m_maximum[ i ];
+
+            minimum = qMax( minimum, hint.minimum );
+
+            if ( hint.maximum < QskLayoutConstraint::unlimited )
+                maximum = hint.maximum;
+            maximum = qMax( minimum, maximum );
+
+            m_preferred[ i ] = qBound( minimum,
+                qMax( m_preferred[ i ], hint.preferred ), maximum );
+        }
+        else if ( !( flags & ( Used | UserStretch ) ) )
+        {
+            flags |= Ignored;
+        }
+
+        if ( ( flags & Used ) && ( flags & IgnoreFlagOnly ) )
+            m_hasIgnoreFlag = true;
+    }
+
+    /*
+        Linear layouts never have spanning items,
+        so they don't pay for what follows
+     */
+    if ( !m_spannedCells.empty() )
+        distributeSpannedCells();
+
+    m_boundary = total( 0, m_count );
+}
+
+qreal QskLayoutChain::boundary( Qt::SizeHint which ) const
+{
+    return m_boundary.value( which );
+}
+
+void QskLayoutChain::resolve( qreal size )
+{
+    m_positions.resize( m_count );
+    m_sizes.resize( m_count );
+
+    if ( m_count > 0 )
+    {
+        distribute( 0, m_count, size, m_boundary,
+            m_positions.data(), m_sizes.data() );
+    }
+}
+
+qreal QskLayoutChain::length( int index, int span ) const
+{
+    const int last = qMin( index + qMax( span, 1 ), m_count ) - 1;
+    if ( last < index )
+        return 0.0;
+
+    qreal length = m_sizes[ last ];
+    if ( last != index )
+        length += m_positions[ last ] - m_positions[ index ];
+
+    return length;
+}
+
+inline const qreal* QskLayoutChain::values( int which ) const
+{
+    switch ( which )
+    {
+        case Qt::MinimumSize:
+            return m_minimum.data();
+
+        case Qt::PreferredSize:
+            return m_preferred.data();
+
+        default:
+            return m_maximum.data();
+    }
+}
+
+void QskLayoutChain::combine( int index, const Hint& hint )
+{
+    auto& minimum = m_minimum[ index ];
+    auto& preferred = m_preferred[ index ];
+    auto& maximum = m_maximum[ index ];
+
+    const qreal unlimited = QskLayoutConstraint::unlimited;
+
+    minimum = qMax( minimum, hint.minimum );
+
+    /*
+        An unlimited maximum of one item does not
+        extend the limit of the other items.
+     */
+    qreal maxMaximum;
+    if ( maximum == unlimited && hint.maximum != unlimited )
+        maxMaximum = hint.maximum;
+    else if ( hint.maximum == unlimited && maximum != unlimited )
+        maxMaximum = maximum;
+    else
+        maxMaximum = qMax( maximum, hint.maximum );
+
+    maximum = qMax( minimum, maxMaximum );
+    preferred = qBound( minimum, qMax( preferred, hint.preferred ), maximum );
+}
+
+QskLayoutChain::Hint QskLayoutChain::total( int start, int end ) const
+{
+    Hint hint;
+
+    if ( start < end )
+    {
+        hint.maximum = 0.0;
+
+        qreal nextSpacing = 0.0;
+
+        for ( int i = start; i < end; i++ )
+        {
+            if ( m_flags[ i ] & Ignored )
+                continue;
+
+            hint.minimum += m_minimum[ i ] + nextSpacing;
+            hint.preferred += m_preferred[ i ] + nextSpacing;
+
+            // cells without stretch factor do not grow beyond their preferred size
+            hint.maximum += ( ( m_stretch[ i ] == 0 )
+                ? m_preferred[ i ] : m_maximum[ i ] ) + nextSpacing;
+
+            nextSpacing = m_spacing[ i ];
+        }
+    }
+
+    return hint;
+}
+
+void QskLayoutChain::steal( int start, int end, int which,
+    qreal* positions, qreal* sizes ) const
+{
+    const qreal* values = this->values( which );
+
+    qreal offset = 0.0;
+    qreal nextSpacing = 0.0;
+
+    for ( int i = start; i < end; i++ )
+    {
+        qreal size = 0.0;
+
+        if ( !( m_flags[ i ] & Ignored ) )
+        {
+            size = values[ i ];
+
+            offset += nextSpacing;
+            nextSpacing = m_spacing[ i ];
+        }
+
+        *positions++ = offset;
+        *sizes++ = size;
+
+        offset += size;
+    }
+}
+
+void QskLayoutChain::distribute( int start, int end, qreal targetSize,
+    const Hint& totalHint, qreal* positions, qreal* sizes ) const
+{
+    const int n = end - start;
+
+    QVarLengthArray< qreal > newSizes( n );
+    QVarLengthArray< qreal > factors( n );
+
+    qreal sumFactors = 0.0;
+    qreal sumAvailable = 0.0;
+
+    int sumStretches = 0;
+    for ( int i = start; i < end; i++ )
+    {
+        if ( m_stretch[ i ] > 0 )
+            sumStretches += m_stretch[ i ];
+    }
+
+    if ( targetSize < totalHint.preferred )
+    {
+        steal( start, end, Qt::MinimumSize, positions, sizes );
+
+        sumAvailable = targetSize - totalHint.minimum;
+        if ( sumAvailable > 0.0 )
+        {
+            /*
+                Cells, that are far above their minimum give up
+                more space than the others.
+             */
+            const qreal sumDesired = totalHint.preferred - totalHint.minimum;
+
+            for ( int i = 0; i < n; i++ )
+            {
+                const int k = start + i;
+
+                factors[ i ] = 0.0;
+
+                if ( !( m_flags[ k ] & Ignored ) )
+                {
+                    const qreal desired = m_preferred[ k ] - m_minimum[ k ];
+                    factors[ i ] = qskGrowthFactor( desired, sumAvailable, sumDesired );
+                    sumFactors += factors[ i ];
+                }
+            }
+
+            for ( int i = 0; i < n; i++ )
+            {
+                const qreal delta = ( sumFactors > 0.0 )
+                    ? sumAvailable * factors[ i ] / sumFactors : 0.0;
+
+                newSizes[ i ] = sizes[ i ] + delta;
+            }
+        }
+    }
+    else
+    {
+        const bool isLargerThanMaximum = ( targetSize > totalHint.maximum );
+
+        if ( isLargerThanMaximum )
+        {
+            steal( start, end, Qt::MaximumSize, positions, sizes );
+            sumAvailable = targetSize - totalHint.maximum;
+        }
+        else
+        {
+            steal( start, end, Qt::PreferredSize, positions, sizes );
+            sumAvailable = targetSize - totalHint.preferred;
+        }
+
+        if ( sumAvailable > 0.0 )
+        {
+            qreal sumCurrentAvailable = sumAvailable;
+            bool somethingHasAMaximumSize = false;
+
+            qreal sumSizes = 0.0;
+            for ( int i = 0; i < n; i++ )
+                sumSizes += sizes[ i ];
+
+            for ( int i = 0; i < n; i++ )
+            {
+                const int k = start + i;
+
+                if ( m_flags[ k ] & Ignored )
+                {
+                    newSizes[ i ] = 0.0;
+                    factors[ i ] = 0.0;
+                    continue;
+                }
+
+                qreal boxSize;
+                qreal desired;
+
+                if ( isLargerThanMaximum )
+                {
+                    // beyond the maximum only the limits of the row/column count
+                    boxSize = m_maximum[ k ];
+                    desired = m_userHints[ k ].maximum - boxSize;
+                }
+                else
+                {
+                    boxSize = m_preferred[ k ];
+                    desired = m_maximum[ k ] - boxSize;
+                }
+
+                if ( desired <= 0.0 )
+                {
+                    newSizes[ i ] = sizes[ i ];
+                    factors[ i ] = 0.0;
+                    continue;
+                }
+
+                const int stretch = m_stretch[ k ];
+
+                if ( sumStretches == 0 )
+                {
+                    if ( m_hasIgnoreFlag || sizes[ i ] == 0.0 )
+                        factors[ i ] = ( stretch < 0 ) ? 1.0 : 0.0;
+                    else
+                        factors[ i ] = ( stretch < 0 ) ? sizes[ i ] : 0.0;
+                }
+                else if ( stretch == sumStretches )
+                {
+                    factors[ i ] = 1.0;
+                }
+                else if ( stretch <= 0 )
+                {
+                    factors[ i ] = 0.0;
+                }
+                else
+                {
+                    qreal ultimateSize;
+                    qreal ultimateSumSizes;
+
+                    const qreal x = ( ( stretch * sumSizes ) - ( sumStretches * boxSize ) )
+                        / ( sumStretches - stretch );
+
+                    if ( x >= 0.0 )
+                    {
+                        ultimateSize = boxSize + x;
+                        ultimateSumSizes = sumSizes + x;
+                    }
+                    else
+                    {
+                        ultimateSize = boxSize;
+                        ultimateSumSizes = ( sumStretches * boxSize ) / stretch;
+                    }
+
+                    /*
+                        Giving some extra space for a smooth transition, where the
+                        stretch factors are not fully respected.
+                     */
+                    ultimateSize = ultimateSize * 3 / 2;
+                    ultimateSumSizes = ultimateSumSizes * 3 / 2;
+
+                    const qreal beta = ultimateSumSizes - sumSizes;
+                    if ( beta == 0.0 )
+                    {
+                        factors[ i ] = 1.0;
+                    }
+                    else
+                    {
+                        const qreal alpha = qMin( sumCurrentAvailable, beta );
+
+                        const qreal ultimateFactor =
+                            ( stretch * ultimateSumSizes / sumStretches ) - boxSize;
+
+                        const qreal transitionalFactor =
+                            sumCurrentAvailable * ( ultimateSize - boxSize ) / beta;
+
+                        factors[ i ] = ( ( alpha * ultimateFactor )
+                            + ( ( beta - alpha ) * transitionalFactor ) ) / beta;
+                    }
+                }
+
+                sumFactors += factors[ i ];
+
+                if ( desired < sumCurrentAvailable )
+                    somethingHasAMaximumSize = true;
+
+                newSizes[ i ] = -1.0;
+            }
+
+            /*
+                Cells reaching their maximum are fixed, and what
+                they can't take is distributed between the others.
+             */
+            bool keepGoing = somethingHasAMaximumSize;
+            while ( keepGoing )
+            {
+                keepGoing = false;
+
+                for ( int i = 0; i < n; i++ )
+                {
+                    if ( newSizes[ i ] >= 0.0 )
+                        continue;
+
+                    const int k = start + i;
+
+                    const qreal maxSize = isLargerThanMaximum
+                        ? m_userHints[ k ].maximum : m_maximum[ k ];
+
+                    const qreal available = ( sumFactors > 0.0 )
+                        ? sumCurrentAvailable * factors[ i ] / sumFactors : 0.0;
+
+                    if ( sizes[ i ] + available >= maxSize )
+                    {
+                        newSizes[ i ] = maxSize;
+
+                        sumCurrentAvailable -= maxSize - sizes[ i ];
+                        sumFactors -= factors[ i ];
+
+                        keepGoing = ( sumCurrentAvailable > 0.0 );
+                        if ( !keepGoing )
+                            break;
+                    }
+                }
+            }
+
+            for ( int i = 0; i < n; i++ )
+            {
+                if ( newSizes[ i ] < 0.0 )
+                {
+                    const qreal delta = ( sumFactors > 0.0 )
+                        ? sumCurrentAvailable * factors[ i ] / sumFactors : 0.0;
+
+                    newSizes[ i ] = sizes[ i ] + delta;
+                }
+            }
+        }
+    }
+
+    if ( sumAvailable > 0.0 )
+    {
+        qreal offset = 0.0;
+
+        for ( int i = 0; i < n; i++ )
+        {
+            const qreal delta = newSizes[ i ] - sizes[ i ];
+
+            positions[ i ] += offset;
+            sizes[ i ] += delta;
+
+            offset += delta;
+        }
+    }
+}
+
+void QskLayoutChain::distributeSpannedCells()
+{
+    std::stable_sort( m_spannedCells.begin(), m_spannedCells.end(),
+        []( const SpannedCell& cell1, const SpannedCell& cell2 )
+        {
+            if ( cell1.index != cell2.index )
+                return cell1.index < cell2.index;
+
+            return cell1.span < cell2.span;
+        } );
+
+    // merging the cells with the same range
+
+    size_t count = 0;
+
+    for ( size_t i = 0; i < m_spannedCells.size(); i++ )
+    {
+        const auto& cell = m_spannedCells[ i ];
+
+        if ( count > 0 )
+        {
+            auto& mergedCell = m_spannedCells[ count - 1 ];
+
+            if ( mergedCell.index == cell.index && mergedCell.span == cell.span )
+            {
+                auto& hint = mergedCell.hint;
+
+                hint.minimum = qMax( hint.minimum, cell.hint.minimum );
+                hint.maximum = qMax( hint.minimum, qMax( hint.maximum, cell.hint.maximum ) );
+                hint.preferred = qBound( hint.minimum,
+                    qMax( hint.preferred, cell.hint.preferred ), hint.maximum );
+
+                mergedCell.stretch = cell.stretch;
+                continue;
+            }
+        }
+
+        m_spannedCells[ count++ ] = cell;
+    }
+
+    m_spannedCells.resize( count );
+
+    /*
+        What the spanning cells need beyond the sum of the cells
+        they are covering is distributed like it would happen, when
+        resizing the covered cells to the size of the spanning cell.
+     */
+    for ( const auto& cell : m_spannedCells )
+    {
+        const int start = cell.index;
+        const int end = start + cell.span;
+
+        const Hint totalHint = total( start, end );
+
+        QVarLengthArray< Hint > extras( cell.span );
+        QVarLengthArray< qreal > positions( cell.span );
+        QVarLengthArray< qreal > sizes( cell.span );
+
+        for ( int which = Qt::MinimumSize; which <= Qt::MaximumSize; which++ )
+        {
+            const qreal extra = ( which == Qt::MaximumSize )
+                ? totalHint.value( which ) - cell.hint.value( which )
+                : cell.hint.value( which ) - totalHint.value( which );
+
+            if ( extra > 0.0 )
+            {
+                distribute( start, end, cell.hint.value( which ),
+                    totalHint, positions.data(), sizes.data() );
+
+                for ( int i = 0; i < cell.span; i++ )
+                    extras[ i ].value( which ) = sizes[ i ];
+            }
+        }
+
+        for ( int i = 0; i < cell.span; i++ )
+        {
+            combine( start + i, extras[ i ] );
+
+            if ( cell.stretch != 0 )
+                m_stretch[ start + i ] = qMax( m_stretch[ start + i ], cell.stretch );
+        }
+    }
+}
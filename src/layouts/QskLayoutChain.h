@@ -0,0 +1,123 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_LAYOUT_CHAIN_H
+#define QSK_LAYOUT_CHAIN_H
+
+#include "QskGlobal.h"
+
+#include <qnamespace.h>
+#include <vector>
+
+/*
+    The cells of one orientation - the rows or the columns - of a layout,
+    and the distribution of the available space between them.
+
+    The hints are stored as structure of arrays, so that the solver runs
+    over contiguous memory. The arrays are kept between the layout passes
+    to avoid allocations.
+
+    The distribution is the same as the one of QGridLayoutEngine:
+    below the preferred size the cells shrink proportional to what they
+    are above their minimum, above the preferred size they grow according
+    to their stretch factors or - without stretch factors - proportional
+    to their size.
+ */
+
+class QskLayoutChain
+{
+  public:
+    QskLayoutChain();
+    ~QskLayoutChain();
+
+    void reset( int count );
+
+    void setSpacing( int index, qreal spacing );
+    void setUserHints( int index, int stretch,
+        qreal minimum, qreal preferred, qreal maximum );
+
+    void addCell( int index, int span, int stretch,
+        qreal minimum, qreal preferred, qreal maximum, bool ignoreFlag );
+
+    void finish();
+
+    int count() const;
+    qreal boundary( Qt::SizeHint ) const;
+
+    void resolve( qreal size );
+
+    qreal position( int index ) const;
+    qreal length( int index, int span ) const;
+
+  private:
+    class Hint
+    {
+      public:
+        Hint();
+
+        qreal value( int which ) const;
+        qreal& value( int which );
+
+        qreal minimum;
+        qreal preferred;
+        qreal maximum;
+    };
+
+    class SpannedCell
+    {
+      public:
+        int index;
+        int span;
+        int stretch;
+        Hint hint;
+    };
+
+    const qreal* values( int which ) const;
+
+    void combine( int index, const Hint& );
+    Hint total( int start, int end ) const;
+
+    void steal( int start, int end, int which,
+        qreal* positions, qreal* sizes ) const;
+
+    void distribute( int start, int end, qreal size,
+        const Hint& total, qreal* positions, qreal* sizes ) const;
+
+    void distributeSpannedCells();
+
+    int m_count;
+    bool m_hasIgnoreFlag;
+
+    // one entry for each cell
+    std::vector< qreal > m_minimum;
+    std::vector< qreal > m_preferred;
+    std::vector< qreal > m_maximum;
+    std::vector< qreal > m_spacing;
+    std::vector< int > m_stretch;
+    std::vector< unsigned char > m_flags;
+
+    // hints, that have been set for the row/column and not for an item
+    std::vector< Hint > m_userHints;
+
+    std::vector< SpannedCell > m_spannedCells;
+
+    Hint m_boundary;
+
+    // results of resolve()
+    std::vector< qreal > m_positions;
+    std::vector< qreal > m_sizes;
+};
+
+inline int QskLayoutChain::count() const
+{
+    return m_count;
+}
+
+inline qreal QskLayoutChain::position( int index ) const
+{
+    return m_positions[ index ];
+}
+
+#endif
@@ -7,17 +7,83 @@
 #include "QskControl.h"
 #include "QskSizePolicy.h"
 
+#include <qhash.h>
+#include <qmetaobject.h>
+
 #include <functional>
 
-static inline qreal qskHintFor(
-    const QQuickItem* item, const char* method, qreal widthOrHeight )
+namespace
+{
+    /*
+        Looking up a method by its signature is expensive, but the result
+        depends on the class only. So we do it once per meta object.
+     */
+    class ConstraintMethods
+    {
+      public:
+        enum Method
+        {
+            HasHeightForWidth,
+            HasWidthForHeight,
+            HeightForWidth,
+            WidthForHeight,
+
+            MethodCount
+        };
+
+        ConstraintMethods( const QMetaObject* metaObject = nullptr )
+        {
+            static const char* signatures[] =
+            {
+                "hasHeightForWidth()",
+                "hasWidthForHeight()",
+                "heightForWidth(qreal)",
+                "widthForHeight(qreal)"
+            };
+
+            for ( int i = 0; i < MethodCount; i++ )
+            {
+                m_indexes[ i ] = metaObject
+                    ? metaObject->indexOfMethod( signatures[ i ] ) : -1;
+            }
+        }
+
+        inline int indexOf( Method method ) const
+        {
+            return m_indexes[ method ];
+        }
+
+      private:
+        int m_indexes[ MethodCount ];
+    };
+}
+
+static inline QMetaMethod qskConstraintMethod(
+    const QQuickItem* item, ConstraintMethods::Method method )
+{
+    // layouts are calculated in the GUI thread only
+    static QHash< const QMetaObject*, ConstraintMethods > table;
+
+    const auto metaObject = item->metaObject();
+
+    auto it = table.find( metaObject );
+    if ( it == table.end() )
+        it = table.insert( metaObject, ConstraintMethods( metaObject ) );
+
+    const int index = it->indexOf( method );
+    return ( index >= 0 ) ? metaObject->method( index ) : QMetaMethod();
+}
+
+static inline qreal qskHintFor( const QQuickItem* item,
+    ConstraintMethods::Method method, qreal widthOrHeight )
 {
-    if ( item->metaObject()->indexOfMethod( method ) >= 0 )
+    const auto metaMethod = qskConstraintMethod( item, method );
+    if ( metaMethod.isValid() )
     {
         qreal value;
 
-        ( void ) QMetaObject::invokeMethod(
-            const_cast< QQuickItem* >( item ), method, Qt::DirectConnection,
+        ( void ) metaMethod.invoke(
+            const_cast< QQuickItem* >( item ), Qt::DirectConnection,
             Q_RETURN_ARG( qreal, value ), Q_ARG( qreal, widthOrHeight ) );
 
         return value;
@@ -26,14 +92,16 @@ static inline qreal qskHintFor(
     return -1;
 }
 
-static inline bool qskHasHintFor( const QQuickItem* item, const char* method )
+static inline bool qskHasHintFor(
+    const QQuickItem* item, ConstraintMethods::Method method )
 {
-    if ( item->metaObject()->indexOfMethod( method ) >= 0 )
+    const auto metaMethod = qskConstraintMethod( item, method );
+    if ( metaMethod.isValid() )
     {
         bool enabled;
 
-        ( void ) QMetaObject::invokeMethod( const_cast< QQuickItem* >( item ),
-            method, Qt::DirectConnection, Q_RETURN_ARG( bool, enabled ) );
+        ( void ) metaMethod.invoke( const_cast< QQuickItem* >( item ),
+            Qt::DirectConnection, Q_RETURN_ARG( bool, enabled ) );
 
         return enabled;
     }
@@ -67,8 +135,8 @@ bool QskLayoutConstraint::hasDynamicConstraint( const QQuickItem* item )
             ( policy.verticalPolicy() == QskSizePolicy::Constrained );
     }
 
-    return qskHasHintFor( item, "hasHeightForWidth" ) ||
-        qskHasHintFor( item, "hasWidthForHeight" );
+    return qskHasHintFor( item, ConstraintMethods::HasHeightForWidth ) ||
+        qskHasHintFor( item, ConstraintMethods::HasWidthForHeight );
 }
 
 qreal QskLayoutConstraint::heightForWidth( const QQuickItem* item, qreal width )
@@ -76,7 +144,7 @@ qreal QskLayoutConstraint::heightForWidth( const QQuickItem* item, qreal width )
     if ( auto control = qskControlCast( item ) )
         return control->heightForWidth( width );
 
-    return qskHintFor( item, "heightForWidth", width );
+    return qskHintFor( item, ConstraintMethods::HeightForWidth, width );
 }
 
 qreal QskLayoutConstraint::widthForHeight( const QQuickItem* item, qreal height )
@@ -84,7 +152,7 @@ qreal QskLayoutConstraint::widthForHeight( const QQuickItem* item, qreal height
     if ( auto control = qskControlCast( item ) )
         return control->widthForHeight( height );
 
-    return qskHintFor( item, "widthForHeight", height );
+    return qskHintFor( item, ConstraintMethods::WidthForHeight, height );
 }
 
 qreal QskLayoutConstraint::constrainedMetric(
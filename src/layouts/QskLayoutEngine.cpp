@@ -6,6 +6,8 @@
 #include "QskLayoutEngine.h"
 #include "QskLayoutItem.h"
 
+#include <qglobalstatic.h>
+
 static inline bool qskIsColliding(
     const QskLayoutEngine* engine, QskLayoutItem* item )
 {
@@ -78,8 +80,69 @@ namespace
     };
 }
 
+/*
+    As long as the style info does not depend on the theme we can
+    share one instance instead of creating one for each call
+ */
+Q_GLOBAL_STATIC( LayoutStyleInfo, qskLayoutStyleInfo )
+
+static inline qreal qskSpacing(
+    const QGridLayoutEngine* engine, Qt::Orientation orientation )
+{
+    if ( qskLayoutStyleInfo.isDestroyed() )
+    {
+        // layouts being updated during the global destruction
+        const LayoutStyleInfo styleInfo;
+        return engine->spacing( orientation, &styleInfo );
+    }
+
+    return engine->spacing( orientation, qskLayoutStyleInfo );
+}
+
+static inline qreal qskHintValue( const QSizeF& hint, Qt::Orientation orientation )
+{
+    return ( orientation == Qt::Horizontal ) ? hint.width() : hint.height();
+}
+
+static void qskAddCell( QskLayoutChain& chain, const QskLayoutItem* layoutItem,
+    Qt::Orientation orientation, qreal constraint )
+{
+    QSizeF constraintSize( -1.0, -1.0 );
+
+    if ( orientation == Qt::Horizontal )
+        constraintSize.setHeight( constraint );
+    else
+        constraintSize.setWidth( constraint );
+
+    const auto policy = layoutItem->sizePolicy( orientation );
+
+    const qreal preferred = qskHintValue(
+        layoutItem->sizeHint( Qt::PreferredSize, constraintSize ), orientation );
+
+    qreal minimum = preferred;
+    if ( policy & QLayoutPolicy::ShrinkFlag )
+    {
+        minimum = qskHintValue(
+            layoutItem->sizeHint( Qt::MinimumSize, constraintSize ), orientation );
+    }
+
+    qreal maximum = preferred;
+    if ( policy & ( QLayoutPolicy::GrowFlag | QLayoutPolicy::ExpandFlag ) )
+    {
+        maximum = qskHintValue(
+            layoutItem->sizeHint( Qt::MaximumSize, constraintSize ), orientation );
+    }
+
+    const bool ignoreFlag = policy & QLayoutPolicy::IgnoreFlag;
+
+    chain.addCell( layoutItem->firstRow( orientation ),
+        layoutItem->rowSpan( orientation ), layoutItem->stretchFactor( orientation ),
+        minimum, ignoreFlag ? minimum : preferred, maximum, ignoreFlag );
+}
+
 QskLayoutEngine::QskLayoutEngine()
     : QGridLayoutEngine( Qt::AlignVCenter, false /*snapToPixelGrid*/ )
+    , m_indexesDirty( false )
 {
     /*
         snapToPixelGrid rounds x/y, what might lead to losing a pixel.
@@ -94,12 +157,147 @@ QskLayoutEngine::~QskLayoutEngine()
 
 void QskLayoutEngine::setGeometries( const QRectF rect )
 {
-    const LayoutStyleInfo styleInfo;
-    QGridLayoutEngine::setGeometries( rect, &styleInfo );
+    if ( rowCount() < 1 || columnCount() < 1 )
+        return;
+
+    if ( hasDynamicConstraint() && constraintOrientation() == Qt::Horizontal )
+    {
+        // the widths depend on the heights
+
+        updateChain( Qt::Vertical, -1.0, rect.height() );
+        updateChain( Qt::Horizontal, rect.height(), rect.width() );
+    }
+    else
+    {
+        updateChain( Qt::Horizontal, -1.0, rect.width() );
+        updateChain( Qt::Vertical, rect.width(), rect.height() );
+    }
+
+    const bool isMirrored = ( visualDirection() == Qt::RightToLeft );
+
+    for ( auto gridItem : qAsConst( q_items ) )
+    {
+        auto layoutItem = static_cast< QskLayoutItem* >( gridItem );
+
+        const int row = layoutItem->firstRow();
+        const int column = layoutItem->firstColumn();
+
+        const qreal x = rect.x() + m_columns.position( column );
+        const qreal y = rect.y() + m_rows.position( row );
+
+        const qreal width = m_columns.length( column, layoutItem->columnSpan() );
+        const qreal height = m_rows.length( row, layoutItem->rowSpan() );
+
+        auto geometry = layoutItem->geometryWithin( x, y, width, height,
+            -1.0, effectiveAlignment( layoutItem ), false );
+
+        if ( isMirrored )
+            geometry.moveRight( rect.right() - ( geometry.left() - rect.left() ) );
+
+        layoutItem->setGeometry( geometry );
+    }
+}
+
+void QskLayoutEngine::updateChain( Qt::Orientation orientation,
+    qreal constraint, qreal size ) const
+{
+    /*
+        constraint: the length, the other chain has been resolved for
+        right before. Only items with a dynamic constraint depend on it.
+     */
+
+    const bool isHorizontal = ( orientation == Qt::Horizontal );
+
+    auto& chain = isHorizontal ? m_columns : m_rows;
+    auto& state = m_states[ isHorizontal ? 0 : 1 ];
+
+    if ( !hasDynamicConstraint() )
+        constraint = -1.0;
+
+    if ( !state.isValid || constraint != state.constraint )
+    {
+        const QskLayoutChain* constraints = nullptr;
+        if ( constraint >= 0.0 )
+            constraints = isHorizontal ? &m_rows : &m_columns;
+
+        setupChain( orientation, constraints );
+
+        state.isValid = true;
+        state.constraint = constraint;
+        state.size = -1.0;
+    }
+
+    if ( size >= 0.0 && size != state.size )
+    {
+        chain.resolve( size );
+        state.size = size;
+    }
+}
+
+void QskLayoutEngine::setupChain( Qt::Orientation orientation,
+    const QskLayoutChain* constraints ) const
+{
+    const auto other = ( orientation == Qt::Horizontal ) ? Qt::Vertical : Qt::Horizontal;
+    auto& chain = ( orientation == Qt::Horizontal ) ? m_columns : m_rows;
+
+    const int count = rowCount( orientation );
+    chain.reset( count );
+
+    const qreal defaultSpacing = spacing( orientation );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const qreal spacingHint = rowSpacing( i, orientation );
+        chain.setSpacing( i, ( spacingHint >= 0.0 ) ? spacingHint : defaultSpacing );
+
+        chain.setUserHints( i, rowStretchFactor( i, orientation ),
+            rowSizeHint( Qt::MinimumSize, i, orientation ),
+            rowSizeHint( Qt::PreferredSize, i, orientation ),
+            rowSizeHint( Qt::MaximumSize, i, orientation ) );
+    }
+
+    for ( const auto gridItem : q_items )
+    {
+        const auto layoutItem = static_cast< const QskLayoutItem* >( gridItem );
+        if ( layoutItem->isIgnored() )
+            continue;
+
+        qreal constraint = -1.0;
+
+        if ( constraints && layoutItem->hasDynamicConstraint()
+            && layoutItem->dynamicConstraintOrientation() == orientation )
+        {
+            constraint = constraints->length(
+                layoutItem->firstRow( other ), layoutItem->rowSpan( other ) );
+        }
+
+        qskAddCell( chain, layoutItem, orientation, constraint );
+    }
+
+    chain.finish();
 }
 
 void QskLayoutEngine::insertLayoutItem( QskLayoutItem* item, int index )
 {
+    const bool isAppending = ( index < 0 ) || ( index >= itemCount() );
+
+    if ( !m_indexesDirty )
+    {
+        /*
+            Appending is the most common operation and does not
+            shift the indexes of the other items.
+         */
+        if ( isAppending )
+        {
+            if ( item->item() )
+                m_indexes.insert( item->item(), itemCount() );
+        }
+        else
+        {
+            m_indexesDirty = true;
+        }
+    }
+
     if ( qskIsColliding( this, item ) )
     {
         // It is totally valid to have more than one item in the same cell
@@ -113,6 +311,82 @@ void QskLayoutEngine::insertLayoutItem( QskLayoutItem* item, int index )
     {
         insertItem( item, index );
     }
+
+    invalidate();
+}
+
+void QskLayoutEngine::removeLayoutItem( QskLayoutItem* item )
+{
+    if ( !m_indexesDirty )
+    {
+        if ( layoutItemAt( itemCount() - 1 ) == item )
+        {
+            if ( item->item() )
+                m_indexes.remove( item->item() );
+        }
+        else
+        {
+            m_indexesDirty = true;
+        }
+    }
+
+    removeItem( item );
+    invalidate();
+}
+
+void QskLayoutEngine::invalidate()
+{
+    QGridLayoutEngine::invalidate();
+
+    m_states[ 0 ].isValid = false;
+    m_states[ 1 ].isValid = false;
+}
+
+void QskLayoutEngine::invalidateSizeHints()
+{
+    for ( auto item : qAsConst( q_items ) )
+        static_cast< QskLayoutItem* >( item )->invalidateSizeHints();
+
+    invalidate();
+}
+
+void QskLayoutEngine::setSpacing( qreal spacing, Qt::Orientations orientations )
+{
+    QGridLayoutEngine::setSpacing( spacing, orientations );
+    invalidate();
+}
+
+void QskLayoutEngine::setRowSpacing(
+    int row, qreal spacing, Qt::Orientation orientation )
+{
+    QGridLayoutEngine::setRowSpacing( row, spacing, orientation );
+    invalidate();
+}
+
+void QskLayoutEngine::setRowStretchFactor(
+    int row, int stretch, Qt::Orientation orientation )
+{
+    QGridLayoutEngine::setRowStretchFactor( row, stretch, orientation );
+    invalidate();
+}
+
+void QskLayoutEngine::setRowSizeHint( Qt::SizeHint which,
+    int row, qreal size, Qt::Orientation orientation )
+{
+    QGridLayoutEngine::setRowSizeHint( which, row, size, orientation );
+    invalidate();
+}
+
+void QskLayoutEngine::insertRow( int row, Qt::Orientation orientation )
+{
+    QGridLayoutEngine::insertRow( row, orientation );
+    invalidate();
+}
+
+void QskLayoutEngine::removeRows( int row, int count, Qt::Orientation orientation )
+{
+    QGridLayoutEngine::removeRows( row, count, orientation );
+    invalidate();
 }
 
 int QskLayoutEngine::indexAt( int row, int column ) const
@@ -151,23 +425,86 @@ QskLayoutItem* QskLayoutEngine::layoutItemAt(
 
 int QskLayoutEngine::indexOf( const QQuickItem* item ) const
 {
-    // linear search might become slow for many items,
-    // better introduce some sort of hash table TODO ...
+    if ( item == nullptr )
+    {
+        // spacers or stretches are not in the lookup table
+
+        for ( int i = q_items.count() - 1; i >= 0; --i )
+        {
+            const auto layoutItem = static_cast< const QskLayoutItem* >( q_items[ i ] );
+            if ( layoutItem->item() == nullptr )
+                return i;
+        }
+
+        return -1;
+    }
+
+    if ( m_indexesDirty )
+        updateIndexes();
+
+    auto it = m_indexes.constFind( item );
+    if ( it == m_indexes.constEnd() )
+        return -1;
+
+    const auto layoutItem = layoutItemAt( it.value() );
+    if ( layoutItem && layoutItem->item() == item )
+        return it.value();
+
+    /*
+        The items have been modified without using insertLayoutItem/removeLayoutItem,
+        what might happen as QGridLayoutEngine is part of our API.
+     */
+    updateIndexes();
+
+    it = m_indexes.constFind( item );
+    return ( it != m_indexes.constEnd() ) ? it.value() : -1;
+}
+
+void QskLayoutEngine::updateIndexes() const
+{
+    m_indexes.clear();
+    m_indexes.reserve( q_items.count() );
 
-    for ( int i = q_items.count() - 1; i >= 0; --i )
+    for ( int i = 0; i < q_items.count(); i++ )
     {
         const auto layoutItem = static_cast< const QskLayoutItem* >( q_items[ i ] );
-        if ( layoutItem->item() == item )
-            return i;
+        if ( layoutItem->item() )
+            m_indexes.insert( layoutItem->item(), i );
     }
 
-    return -1;
+    m_indexesDirty = false;
 }
 
 QSizeF QskLayoutEngine::sizeHint( Qt::SizeHint which, const QSizeF& constraint ) const
 {
-    const LayoutStyleInfo styleInfo;
-    return QGridLayoutEngine::sizeHint( which, constraint, &styleInfo );
+    if ( hasDynamicConstraint() && rowCount() > 0 && columnCount() > 0 )
+    {
+        if ( constraintOrientation() == Qt::Vertical )
+        {
+            if ( constraint.width() >= 0.0 )
+            {
+                updateChain( Qt::Horizontal, -1.0, constraint.width() );
+                updateChain( Qt::Vertical, constraint.width(), -1.0 );
+
+                return QSizeF( m_columns.boundary( which ), m_rows.boundary( which ) );
+            }
+        }
+        else
+        {
+            if ( constraint.height() >= 0.0 )
+            {
+                updateChain( Qt::Vertical, -1.0, constraint.height() );
+                updateChain( Qt::Horizontal, constraint.height(), -1.0 );
+
+                return QSizeF( m_columns.boundary( which ), m_rows.boundary( which ) );
+            }
+        }
+    }
+
+    updateChain( Qt::Horizontal, -1.0, -1.0 );
+    updateChain( Qt::Vertical, -1.0, -1.0 );
+
+    return QSizeF( m_columns.boundary( which ), m_rows.boundary( which ) );
 }
 
 qreal QskLayoutEngine::widthForHeight( qreal height ) const
@@ -184,13 +521,15 @@ qreal QskLayoutEngine::heightForWidth( qreal width ) const
 
 qreal QskLayoutEngine::spacing( Qt::Orientation orientation ) const
 {
-    const LayoutStyleInfo styleInfo;
-    return QGridLayoutEngine::spacing( orientation, &styleInfo );
+    return qskSpacing( this, orientation );
 }
 
 qreal QskLayoutEngine::defaultSpacing( Qt::Orientation orientation )
 {
-    return LayoutStyleInfo().spacing( orientation );
+    if ( qskLayoutStyleInfo.isDestroyed() )
+        return LayoutStyleInfo().spacing( orientation );
+
+    return qskLayoutStyleInfo->spacing( orientation );
 }
 
 #if 1
@@ -234,6 +573,8 @@ void QskLayoutEngine::adjustSpans( int numRows, int numColumns )
         if ( l->hasUnlimitedSpan( Qt::Vertical ) )
             l->setRowSpan( numRows - l->firstRow(), Qt::Vertical );
     }
+
+    invalidate();
 }
 
 #endif
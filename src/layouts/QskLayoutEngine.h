@@ -7,6 +7,9 @@
 #define QSK_LAYOUT_ENGINE_H
 
 #include "QskGlobal.h"
+#include "QskLayoutChain.h"
+
+#include <qhash.h>
 #include <qquickitem.h>
 
 QSK_QT_PRIVATE_BEGIN
@@ -29,6 +32,23 @@ class QskLayoutEngine : public QGridLayoutEngine
     void setGeometries( const QRectF );
 
     void insertLayoutItem( QskLayoutItem* item, int index );
+    void removeLayoutItem( QskLayoutItem* item );
+
+    void invalidate();
+    void invalidateSizeHints();
+
+    /*
+        The setters of QGridLayoutEngine, that have an effect
+        on the rows/columns, need to invalidate the chains
+     */
+    void setSpacing( qreal spacing, Qt::Orientations );
+    void setRowSpacing( int row, qreal spacing, Qt::Orientation = Qt::Vertical );
+    void setRowStretchFactor( int row, int stretch, Qt::Orientation = Qt::Vertical );
+    void setRowSizeHint( Qt::SizeHint, int row, qreal size,
+        Qt::Orientation = Qt::Vertical );
+
+    void insertRow( int row, Qt::Orientation = Qt::Vertical );
+    void removeRows( int row, int count, Qt::Orientation = Qt::Vertical );
 
     QskLayoutItem* layoutItemAt( int index ) const;
     QskLayoutItem* layoutItemAt( int row, int column ) const;
@@ -51,8 +71,50 @@ class QskLayoutEngine : public QGridLayoutEngine
     QSize requiredCells() const;
     void adjustSpans( int numRows, int numColumns );
 #endif
+
+  private:
+    void updateIndexes() const;
+
+    void updateChain( Qt::Orientation, qreal constraint, qreal size ) const;
+    void setupChain( Qt::Orientation, const QskLayoutChain* constraints ) const;
+
+    // lookup table for indexOf, rebuilt lazily after inserting/removing
+    mutable QHash< const QQuickItem*, int > m_indexes;
+    mutable bool m_indexesDirty;
+
+    /*
+        QGridLayoutEngine is only used for storing the items and the
+        row/column settings. The space is distributed by the chains.
+     */
+    mutable QskLayoutChain m_columns;
+    mutable QskLayoutChain m_rows;
+
+    /*
+        The chains are kept until the next invalidation, as a polish cycle
+        usually asks for the same hints several times. constraint is the
+        length of the other chain, that has been used for the hints,
+        size is the length the chain has been resolved for.
+     */
+    class ChainState
+    {
+      public:
+        ChainState();
+
+        bool isValid;
+        qreal constraint;
+        qreal size;
+    };
+
+    mutable ChainState m_states[ 2 ];
 };
 
+inline QskLayoutEngine::ChainState::ChainState()
+    : isValid( false )
+    , constraint( -1.0 )
+    , size( -1.0 )
+{
+}
+
 inline QskLayoutItem* QskLayoutEngine::layoutItemOf( const QQuickItem* item ) const
 {
     return layoutItemAt( indexOf( item ) );
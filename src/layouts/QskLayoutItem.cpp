@@ -6,6 +6,7 @@
 #include "QskLayoutItem.h"
 #include "QskControl.h"
 #include "QskLayoutConstraint.h"
+#include "QskLayoutProfiler.h"
 #include "QskQuick.h"
 
 QskLayoutItem::QskLayoutItem( QQuickItem* item, int row, int column, int rowSpan, int columnSpan )
@@ -17,6 +18,8 @@ QskLayoutItem::QskLayoutItem( QQuickItem* item, int row, int column, int rowSpan
     , m_unlimitedRowSpan( rowSpan <= 0 )
     , m_unlimitedColumnSpan( columnSpan <= 0 )
     , m_updateMode( UpdateWhenVisible )
+    , m_hasDynamicConstraint( false )
+    , m_isDynamicConstraintDirty( true )
 {
 }
 
@@ -30,6 +33,8 @@ QskLayoutItem::QskLayoutItem( const QSizeF& size, int stretch, int row, int colu
     , m_unlimitedRowSpan( false )
     , m_unlimitedColumnSpan( false )
     , m_updateMode( UpdateWhenVisible )
+    , m_hasDynamicConstraint( false )
+    , m_isDynamicConstraintDirty( true )
 {
 }
 
@@ -67,6 +72,15 @@ void QskLayoutItem::setSpacingHint( const QSizeF& hint )
     m_spacingHint = hint;
 }
 
+void QskLayoutItem::invalidateSizeHints()
+{
+    for ( auto& hint : m_sizeHints )
+        hint = QSizeF();
+
+    m_constraint = m_constrainedHint = QSizeF();
+    m_isDynamicConstraintDirty = true;
+}
+
 QSizeF QskLayoutItem::sizeHint(
     Qt::SizeHint whichHint, const QSizeF& constraint ) const
 {
@@ -95,9 +109,35 @@ QSizeF QskLayoutItem::sizeHint(
         }
     }
 
+    if ( whichHint == Qt::PreferredSize && hasDynamicConstraint() )
+    {
+        if ( constraint.width() > 0 || constraint.height() > 0 )
+        {
+            if ( constraint != m_constraint )
+            {
+                m_constrainedHint = itemSizeHint( whichHint, constraint );
+                m_constraint = constraint;
+            }
+
+            return m_constrainedHint;
+        }
+    }
+
+    auto& hint = m_sizeHints[ whichHint ];
+    if ( !hint.isValid() )
+        hint = itemSizeHint( whichHint, QSizeF() );
+
+    return hint;
+}
+
+QSizeF QskLayoutItem::itemSizeHint(
+    Qt::SizeHint whichHint, const QSizeF& constraint ) const
+{
+    QSK_LAYOUT_PROFILE( m_item, SizeHint );
+
     QSizeF hint( 0, 0 );
 
-    if ( whichHint == Qt::PreferredSize && QskLayoutConstraint::hasDynamicConstraint( m_item ) )
+    if ( whichHint == Qt::PreferredSize && hasDynamicConstraint() )
     {
         const quint32 growFlags = QLayoutPolicy::GrowFlag | QLayoutPolicy::ExpandFlag;
 
@@ -202,10 +242,16 @@ void QskLayoutItem::setGeometry( const QRectF& rect )
 
 bool QskLayoutItem::hasDynamicConstraint() const
 {
-    if ( m_item )
-        return QskLayoutConstraint::hasDynamicConstraint( m_item );
+    if ( m_item == nullptr )
+        return false;
 
-    return false;
+    if ( m_isDynamicConstraintDirty )
+    {
+        m_hasDynamicConstraint = QskLayoutConstraint::hasDynamicConstraint( m_item );
+        m_isDynamicConstraintDirty = false;
+    }
+
+    return m_hasDynamicConstraint;
 }
 
 Qt::Orientation QskLayoutItem::dynamicConstraintOrientation() const
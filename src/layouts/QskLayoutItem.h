@@ -64,16 +64,32 @@ class QskLayoutItem : public QGridLayoutItem
     bool hasUnlimitedSpan() const;
     bool hasUnlimitedSpan( Qt::Orientation orientation ) const;
 
+    void invalidateSizeHints();
+
   private:
+    QSizeF itemSizeHint( Qt::SizeHint, const QSizeF& ) const;
+
     QQuickItem* m_item;
     QSizeF m_spacingHint;
 
+    /*
+        The solver asks for the same hints many times during
+        one layout pass. As they are expensive to calculate, we keep
+        them until the item indicates, that they have changed.
+     */
+    mutable QSizeF m_sizeHints[ Qt::MaximumSize + 1 ];
+    mutable QSizeF m_constraint;
+    mutable QSizeF m_constrainedHint;
+
     bool m_isGeometryDirty : 1;
     bool m_isStretchable : 1;
     bool m_retainSizeWhenHidden : 1;
     bool m_unlimitedRowSpan : 1;
     bool m_unlimitedColumnSpan : 1;
     UpdateMode m_updateMode : 2;
+
+    mutable bool m_hasDynamicConstraint : 1;
+    mutable bool m_isDynamicConstraintDirty : 1;
 };
 
 inline QQuickItem* QskLayoutItem::item()
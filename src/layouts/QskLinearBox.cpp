@@ -93,7 +93,7 @@ void QskLinearBox::transpose()
             const int row = layoutItem->firstRow( Qt::Horizontal );
             const int col = layoutItem->firstRow( Qt::Vertical );
 
-            engine().removeItem( layoutItem );
+            engine().removeLayoutItem( layoutItem );
 
             layoutItem->setFirstRow( row, Qt::Vertical );
             layoutItem->setFirstRow( col, Qt::Horizontal );
@@ -363,7 +363,7 @@ void QskLinearBox::rearrange()
         if ( layoutItem->firstRow( Qt::Horizontal ) != col ||
             layoutItem->firstRow( Qt::Vertical ) != row )
         {
-            engine().removeItem( layoutItem );
+            engine().removeLayoutItem( layoutItem );
 
             layoutItem->setFirstRow( col, Qt::Horizontal );
             layoutItem->setFirstRow( row, Qt::Vertical );
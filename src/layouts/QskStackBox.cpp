@@ -9,7 +9,103 @@
 #include "QskLayoutItem.h"
 #include "QskStackBoxAnimator.h"
 
+#include <qbasictimer.h>
+#include <qelapsedtimer.h>
 #include <qpointer.h>
+#include <qset.h>
+
+namespace
+{
+    /*
+        The placeholder for a page, that is created on demand.
+        It becomes the parent of the page, stretching it to its geometry.
+
+        As long as the page is not loaded the placeholder reports the
+        hint, that has been passed with the factory, or the one of
+        the page, when it has been loaded before.
+     */
+    class LazyPage final : public QskControl
+    {
+      public:
+        LazyPage( const QskStackBox::PageFactory& factory,
+                const QSizeF& sizeHint, QQuickItem* parent )
+            : QskControl( parent )
+            , m_factory( factory )
+            , m_sizeHint( sizeHint )
+        {
+            setAutoLayoutChildren( true );
+        }
+
+        inline bool isLoaded() const
+        {
+            return m_page != nullptr;
+        }
+
+        inline QQuickItem* page() const
+        {
+            return m_page;
+        }
+
+        void load()
+        {
+            if ( m_page || !m_factory )
+                return;
+
+            m_page = m_factory();
+            if ( m_page == nullptr )
+                return;
+
+            if ( m_page->parent() == nullptr )
+                m_page->setParent( this );
+
+            m_page->setParentItem( this );
+
+            if ( auto control = qskControlCast( m_page ) )
+                setSizePolicy( control->sizePolicy() );
+
+            resetImplicitSize();
+            polish();
+        }
+
+        void unload()
+        {
+            QQuickItem* page = m_page;
+            if ( page == nullptr )
+                return;
+
+            // keeping the hint of the page, so that the box does not shrink
+            const auto hint = QskControl::contentsSizeHint();
+            if ( hint.width() >= 0.0 || hint.height() >= 0.0 )
+                m_sizeHint = hint;
+
+            m_page = nullptr;
+
+            if ( page->parent() == this )
+                delete page;
+            else
+                page->setParentItem( nullptr );
+
+            resetImplicitSize();
+        }
+
+        QSizeF contentsSizeHint() const override
+        {
+            if ( m_page )
+                return QskControl::contentsSizeHint();
+
+            return m_sizeHint;
+        }
+
+        // running, while the page is not the current one
+        QElapsedTimer idleTimer;
+
+      private:
+        QskStackBox::PageFactory m_factory;
+        QPointer< QQuickItem > m_page;
+
+        QSizeF m_sizeHint;
+    };
+}
 
 static qreal qskConstrainedValue( QskLayoutConstraint::Type type,
     const QskControl* control, qreal widthOrHeight )
@@ -40,11 +136,25 @@ class QskStackBox::PrivateData
   public:
     PrivateData()
         : currentIndex( -1 )
+        , unloadDelay( -1 )
     {
     }
 
+    LazyPage* lazyPage( const QQuickItem* item ) const
+    {
+        if ( item && lazyPages.contains( item ) )
+            return static_cast< LazyPage* >( const_cast< QQuickItem* >( item ) );
+
+        return nullptr;
+    }
+
     int currentIndex;
     QPointer< QskStackBoxAnimator > animator;
+
+    QSet< const QQuickItem* > lazyPages;
+
+    int unloadDelay;
+    QBasicTimer unloadTimer;
 };
 
 QskStackBox::QskStackBox( QQuickItem* parent )
@@ -103,9 +213,147 @@ QskStackBoxAnimator* QskStackBox::effectiveAnimator()
     return nullptr;
 }
 
+int QskStackBox::addPage( const PageFactory& factory, const QSizeF& sizeHint )
+{
+    return insertPage( -1, factory, sizeHint );
+}
+
+int QskStackBox::insertPage( int index,
+    const PageFactory& factory, const QSizeF& sizeHint )
+{
+    auto page = new LazyPage( factory, sizeHint, this );
+    m_data->lazyPages.insert( page );
+
+    insertItem( index, page, Qt::Alignment() );
+
+    return indexOf( page );
+}
+
+void QskStackBox::loadPage( int index )
+{
+    if ( auto page = m_data->lazyPage( itemAtIndex( index ) ) )
+        page->load();
+}
+
+bool QskStackBox::isPageLoaded( int index ) const
+{
+    if ( auto page = m_data->lazyPage( itemAtIndex( index ) ) )
+        return page->isLoaded();
+
+    return true;
+}
+
+QQuickItem* QskStackBox::pageAt( int index ) const
+{
+    auto item = itemAtIndex( index );
+
+    if ( auto page = m_data->lazyPage( item ) )
+        return page->page();
+
+    return item;
+}
+
+int QskStackBox::pageIndex( const QQuickItem* item ) const
+{
+    if ( item == nullptr )
+        return -1;
+
+    // a page created from a factory is a child of its placeholder
+    if ( auto page = m_data->lazyPage( item->parentItem() ) )
+    {
+        if ( page->page() == item )
+            return indexOf( page );
+    }
+
+    return indexOf( item );
+}
+
+void QskStackBox::setPageUnloadDelay( int ms )
+{
+    ms = qMax( ms, -1 );
+
+    if ( ms != m_data->unloadDelay )
+    {
+        m_data->unloadDelay = ms;
+
+        if ( ms < 0 )
+            m_data->unloadTimer.stop();
+        else
+            unloadPages();
+
+        Q_EMIT pageUnloadDelayChanged( ms );
+    }
+}
+
+int QskStackBox::pageUnloadDelay() const
+{
+    return m_data->unloadDelay;
+}
+
+void QskStackBox::unloadPages()
+{
+    m_data->unloadTimer.stop();
+
+    const int delay = m_data->unloadDelay;
+    if ( delay < 0 )
+        return;
+
+    const QskStackBoxAnimator* animator = m_data->animator;
+    const bool isAnimating = animator &&
+        ( animator->isRunning() || animator->isPending() );
+
+    qint64 timeout = -1;
+
+    for ( int i = 0; i < itemCount(); i++ )
+    {
+        auto page = m_data->lazyPage( itemAtIndex( i ) );
+        if ( page == nullptr || !page->isLoaded() || i == m_data->currentIndex )
+            continue;
+
+        qint64 remaining;
+
+        if ( isAnimating &&
+            ( i == animator->startIndex() || i == animator->endIndex() ) )
+        {
+            // not before the transition is over
+            page->idleTimer.start();
+            remaining = qMax( delay, animator->duration() );
+        }
+        else
+        {
+            if ( !page->idleTimer.isValid() )
+                page->idleTimer.start();
+
+            remaining = delay - page->idleTimer.elapsed();
+            if ( remaining <= 0 )
+            {
+                page->unload();
+                continue;
+            }
+        }
+
+        if ( timeout < 0 || remaining < timeout )
+            timeout = remaining;
+    }
+
+    if ( timeout >= 0 )
+        m_data->unloadTimer.start( int( timeout ), this );
+}
+
+void QskStackBox::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() == m_data->unloadTimer.timerId() )
+    {
+        unloadPages();
+        return;
+    }
+
+    Inherited::timerEvent( event );
+}
+
 QQuickItem* QskStackBox::currentItem() const
 {
-    return itemAtIndex( m_data->currentIndex );
+    return pageAt( m_data->currentIndex );
 }
 
 int QskStackBox::currentIndex() const
@@ -113,8 +361,15 @@ int QskStackBox::currentIndex() const
     return m_data->currentIndex;
 }
 
-void QskStackBox::layoutItemRemoved( QskLayoutItem*, int index )
+void QskStackBox::layoutItemRemoved( QskLayoutItem* layoutItem, int index )
 {
+    if ( auto page = m_data->lazyPage( layoutItem->item() ) )
+    {
+        // the placeholder is of no use for anyone else
+        m_data->lazyPages.remove( page );
+        page->deleteLater();
+    }
+
     if ( index == m_data->currentIndex )
     {
         int newIndex = m_data->currentIndex;
@@ -162,10 +417,23 @@ void QskStackBox::setCurrentIndex( int index )
     if ( index == m_data->currentIndex )
         return;
 
-    // stop and complete the running transition
+    // stop the running transition
     auto animator = effectiveAnimator();
     if ( animator )
-        animator->stop();
+    {
+        /*
+            A transition, that waits for a page being created, has
+            not been started yet. It is completed without animation.
+         */
+        if ( animator->isPending() )
+            animator->finish();
+        else
+            animator->stop();
+    }
+
+    // creating the page on demand
+    const bool isLoaded = isPageLoaded( index );
+    loadPage( index );
 
     if ( window() && isVisible() && isInitiallyPainted() && animator )
     {
@@ -178,7 +446,11 @@ void QskStackBox::setCurrentIndex( int index )
         animator->setStartIndex( m_data->currentIndex );
         animator->setEndIndex( index );
         animator->setWindow( window() );
-        animator->start();
+
+        if ( isLoaded )
+            animator->start();
+        else
+            animator->startDeferred();
     }
     else
     {
@@ -192,13 +464,24 @@ void QskStackBox::setCurrentIndex( int index )
             item2->setVisible( true );
     }
 
+    if ( auto page = m_data->lazyPage( itemAtIndex( index ) ) )
+        page->idleTimer.invalidate();
+
+    if ( auto page = m_data->lazyPage( itemAtIndex( m_data->currentIndex ) ) )
+    {
+        page->idleTimer.start();
+
+        if ( m_data->unloadDelay >= 0 && !m_data->unloadTimer.isActive() )
+            m_data->unloadTimer.start( m_data->unloadDelay, this );
+    }
+
     m_data->currentIndex = index;
     Q_EMIT currentIndexChanged( m_data->currentIndex );
 }
 
 void QskStackBox::setCurrentItem( const QQuickItem* item )
 {
-    setCurrentIndex( indexOf( item ) );
+    setCurrentIndex( pageIndex( item ) );
 }
 
 QSizeF QskStackBox::layoutItemsSizeHint() const
@@ -311,6 +594,8 @@ void QskStackBox::layoutItemInserted( QskLayoutItem* layoutItem, int index )
     if ( itemCount() == 1 )
     {
         m_data->currentIndex = 0;
+
+        loadPage( index );
         item->setVisible( true );
 
         Q_EMIT currentIndexChanged( m_data->currentIndex );
@@ -8,6 +8,8 @@
 
 #include "QskIndexedLayoutBox.h"
 
+#include <functional>
+
 class QskStackBoxAnimator;
 
 class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
@@ -20,9 +22,14 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     Q_PROPERTY( QQuickItem* currentItem READ currentItem
         WRITE setCurrentItem NOTIFY currentItemChanged )
 
+    Q_PROPERTY( int pageUnloadDelay READ pageUnloadDelay
+        WRITE setPageUnloadDelay NOTIFY pageUnloadDelayChanged )
+
     using Inherited = QskIndexedLayoutBox;
 
   public:
+    using PageFactory = std::function< QQuickItem*() >;
+
     explicit QskStackBox( QQuickItem* parent = nullptr );
     QskStackBox( bool autoAddChildren, QQuickItem* parent = nullptr );
 
@@ -38,6 +45,33 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     const QskStackBoxAnimator* animator() const;
     QskStackBoxAnimator* animator();
 
+    /*
+        A page, that is inserted as factory, is created, when it
+        becomes the current item for the first time. Until then
+        the stack box holds an empty placeholder at its index,
+        that reports sizeHint as its size hint.
+     */
+    int addPage( const PageFactory&, const QSizeF& sizeHint = QSizeF() );
+    int insertPage( int index, const PageFactory&, const QSizeF& sizeHint = QSizeF() );
+
+    void loadPage( int index );
+    bool isPageLoaded( int index ) const;
+
+    /*
+        pageAt() and pageIndex() resolve the placeholder of a page, that
+        has been inserted as factory, to the created page and vice versa.
+     */
+    QQuickItem* pageAt( int index ) const;
+    int pageIndex( const QQuickItem* ) const;
+
+    /*
+        Pages, that have been created from a factory, are deleted
+        after not being current for the delay. A negative value
+        disables unloading.
+     */
+    void setPageUnloadDelay( int ms );
+    int pageUnloadDelay() const;
+
   public Q_SLOTS:
     void setCurrentIndex( int index );
     void setCurrentItem( const QQuickItem* );
@@ -45,8 +79,11 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
   Q_SIGNALS:
     void currentIndexChanged( int index );
     void currentItemChanged( QQuickItem* );
+    void pageUnloadDelayChanged( int );
 
   protected:
+    void timerEvent( QTimerEvent* ) override;
+
     QskStackBoxAnimator* effectiveAnimator();
     QSizeF layoutItemsSizeHint() const override;
 
@@ -56,6 +93,8 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     void layoutItemInserted( QskLayoutItem*, int index ) override;
     void layoutItemRemoved( QskLayoutItem*, int index ) override;
 
+    void unloadPages();
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
@@ -8,6 +8,11 @@
 #include "QskLayoutItem.h"
 #include "QskStackBox.h"
 
+QSK_QT_PRIVATE_BEGIN
+#include <private/qquickitem_p.h>
+#include <private/qquickshadereffectsource_p.h>
+QSK_QT_PRIVATE_END
+
 static Qsk::Direction qskDirection(
     Qt::Orientation orientation, int from, int to, int itemCount )
 {
@@ -59,7 +64,9 @@ QskStackBoxAnimator::QskStackBoxAnimator( QskStackBox* parent )
     : QObject( parent )
     , m_startIndex( -1 )
     , m_endIndex( -1 )
+    , m_isRenderAnimated( false )
 {
+    m_renderAnimators[ 0 ] = m_renderAnimators[ 1 ] = nullptr;
 }
 
 QskStackBoxAnimator::~QskStackBoxAnimator()
@@ -86,6 +93,52 @@ int QskStackBoxAnimator::endIndex() const
     return m_endIndex;
 }
 
+void QskStackBoxAnimator::startDeferred()
+{
+    finish();
+
+    auto window = this->window();
+    if ( window == nullptr )
+        return;
+
+    if ( auto layoutItem = layoutItemAt( 1 ) )
+    {
+        auto item = layoutItem->item();
+        item->setOpacity( 0.0 );
+        item->setVisible( true );
+    }
+
+    // frameSwapped might be emitted from the scene graph thread
+    m_pendingConnection = connect( window, &QQuickWindow::frameSwapped,
+        this, &QskStackBoxAnimator::startPending, Qt::QueuedConnection );
+
+    window->update();
+}
+
+bool QskStackBoxAnimator::isPending() const
+{
+    return bool( m_pendingConnection );
+}
+
+void QskStackBoxAnimator::startPending()
+{
+    disconnect( m_pendingConnection );
+    m_pendingConnection = QMetaObject::Connection();
+
+    if ( auto layoutItem = layoutItemAt( 1 ) )
+        layoutItem->item()->setOpacity( 1.0 );
+
+    start();
+}
+
+void QskStackBoxAnimator::finish()
+{
+    if ( isPending() )
+        startPending();
+
+    stop();
+}
+
 QskStackBox* QskStackBoxAnimator::stackBox() const
 {
     return static_cast< QskStackBox* >( parent() );
@@ -97,14 +150,55 @@ QskLayoutItem* QskStackBoxAnimator::layoutItemAt( int index ) const
         ( index == 0 ) ? m_startIndex : m_endIndex );
 }
 
+void QskStackBoxAnimator::startRenderAnimator( int index, QQuickItem* item,
+    QskRenderAnimator::Property property, qreal from, qreal to )
+{
+    auto& animator = m_renderAnimators[ index ];
+    if ( animator == nullptr )
+        animator = new QskRenderAnimator( this );
+
+    animator->setTarget( item );
+    animator->setAnimatedProperty( property );
+    animator->setFrom( from );
+    animator->setTo( to );
+    animator->setDuration( duration() );
+    animator->setEasingCurve( easingCurve() );
+
+    animator->start();
+
+    m_isRenderAnimated = true;
+}
+
+void QskStackBoxAnimator::stopRenderAnimators()
+{
+    // syncing the values from the scene graph back to the items
+    for ( auto animator : m_renderAnimators )
+    {
+        if ( animator )
+        {
+            animator->stop();
+            animator->setTarget( nullptr );
+        }
+    }
+
+    m_isRenderAnimated = false;
+}
+
+bool QskStackBoxAnimator::isRenderAnimated() const
+{
+    return m_isRenderAnimated;
+}
+
 QskStackBoxAnimator1::QskStackBoxAnimator1( QskStackBox* parent )
     : QskStackBoxAnimator( parent )
     , m_orientation( Qt::Horizontal )
+    , m_snapshotMode( false )
 {
 }
 
 QskStackBoxAnimator1::~QskStackBoxAnimator1()
 {
+    delete m_snapshot;
 }
 
 void QskStackBoxAnimator1::setOrientation( Qt::Orientation orientation )
@@ -123,6 +217,31 @@ Qt::Orientation QskStackBoxAnimator1::orientation() const
     return m_orientation;
 }
 
+void QskStackBoxAnimator1::setSnapshotMode( bool on )
+{
+    if ( m_snapshotMode != on )
+    {
+        stop();
+        m_snapshotMode = on;
+    }
+}
+
+bool QskStackBoxAnimator1::isSnapshotMode() const
+{
+    return m_snapshotMode;
+}
+
+QQuickItem* QskStackBoxAnimator1::animatedItem( int index ) const
+{
+    if ( index == 0 && m_snapshot )
+        return m_snapshot;
+
+    if ( auto layoutItem = layoutItemAt( index ) )
+        return layoutItem->item();
+
+    return nullptr;
+}
+
 void QskStackBoxAnimator1::setup()
 {
     auto stackBox = this->stackBox();
@@ -158,16 +277,85 @@ void QskStackBoxAnimator1::setup()
             // controlling the item by the animation
 
             layoutItem->setUpdateMode( QskLayoutItem::UpdateNone );
+
+            if ( i == 0 && m_snapshotMode )
+            {
+                /*
+                    The texture is rendered once - hiding the item and
+                    its children from the scene graph, until the
+                    snapshot is removed again.
+
+                    The snapshot is no page: it is created without parent
+                    and marked as transparent for positioners, before it
+                    is added to the stack box. Otherwise a box with
+                    autoAddChildren would insert it into its layout.
+                 */
+                auto snapshot = new QQuickShaderEffectSource();
+                QQuickItemPrivate::get( snapshot )->setTransparentForPositioner( true );
+                snapshot->setParentItem( stackBox );
+
+                snapshot->setSourceItem( item );
+                snapshot->setLive( false );
+                snapshot->setHideSource( true );
+                snapshot->setSmooth( false );
+                snapshot->setZ( item->z() );
+                snapshot->setPosition( item->position() );
+                snapshot->setSize( item->size() );
+
+                m_snapshot = snapshot;
+            }
         }
     }
 
     m_hasClip = stackBox->clip();
     if ( !m_hasClip )
         stackBox->setClip( true );
+
+    if ( QskRenderAnimator::isThreaded() )
+    {
+        const auto property = ( m_orientation == Qt::Horizontal )
+            ? QskRenderAnimator::X : QskRenderAnimator::Y;
+
+        for ( int i = 0; i < 2; i++ )
+        {
+            if ( auto item = animatedItem( i ) )
+            {
+                startRenderAnimator( i, item, property,
+                    itemPosition( i, 0.0 ), itemPosition( i, 1.0 ) );
+            }
+        }
+    }
+}
+
+qreal QskStackBoxAnimator1::itemPosition( int index, qreal value ) const
+{
+    const auto stackBox = this->stackBox();
+
+    if ( m_orientation == Qt::Horizontal )
+    {
+        const qreal off = stackBox->width() * ( value - index );
+
+        if ( m_direction == Qsk::LeftToRight )
+            return m_itemOffset[ index ] - off;
+        else
+            return m_itemOffset[ index ] + off;
+    }
+    else
+    {
+        const qreal off = stackBox->height() * ( value - index );
+
+        if ( m_direction == Qsk::TopToBottom )
+            return m_itemOffset[ index ] + off;
+        else
+            return m_itemOffset[ index ] - off;
+    }
 }
 
 void QskStackBoxAnimator1::advance( qreal value )
 {
+    if ( isRenderAnimated() )
+        return;
+
     auto stackBox = this->stackBox();
 
     for ( int i = 0; i < 2; i++ )
@@ -176,7 +364,7 @@ void QskStackBoxAnimator1::advance( qreal value )
         if ( layoutItem == nullptr )
             continue;
 
-        if ( layoutItem->isGeometryDirty() )
+        if ( layoutItem->isGeometryDirty() && !( i == 0 && m_snapshot ) )
         {
             // the layout tried to replace the item, but we
             // want to have control over the position. But we
@@ -190,31 +378,34 @@ void QskStackBoxAnimator1::advance( qreal value )
                 ( m_orientation == Qt::Horizontal ) ? item->x() : item->y();
         }
 
-        QQuickItem* item = layoutItem->item();
+        QQuickItem* item = animatedItem( i );
 
         if ( m_orientation == Qt::Horizontal )
-        {
-            const qreal off = stackBox->width() * ( value - i );
-
-            if ( m_direction == Qsk::LeftToRight )
-                item->setX( m_itemOffset[ i ] - off );
-            else
-                item->setX( m_itemOffset[ i ] + off );
-        }
+            item->setX( itemPosition( i, value ) );
         else
-        {
-            const qreal off = stackBox->height() * ( value - i );
-
-            if ( m_direction == Qsk::TopToBottom )
-                item->setY( m_itemOffset[ i ] + off );
-            else
-                item->setY( m_itemOffset[ i ] - off );
-        }
+            item->setY( itemPosition( i, value ) );
     }
 }
 
 void QskStackBoxAnimator1::done()
 {
+    stopRenderAnimators();
+
+    // the render animators might have been stopped before reaching the end
+    for ( int i = 0; i < 2; i++ )
+    {
+        if ( auto item = animatedItem( i ) )
+        {
+            if ( m_orientation == Qt::Horizontal )
+                item->setX( itemPosition( i, 1.0 ) );
+            else
+                item->setY( itemPosition( i, 1.0 ) );
+        }
+    }
+
+    delete m_snapshot;
+    m_snapshot = nullptr;
+
     for ( int i = 0; i < 2; i++ )
     {
         if ( QskLayoutItem* layoutItem = layoutItemAt( i ) )
@@ -245,10 +436,25 @@ void QskStackBoxAnimator3::setup()
         layoutItem->item()->setOpacity( 0.0 );
         layoutItem->item()->setVisible( true );
     }
+
+    if ( QskRenderAnimator::isThreaded() )
+    {
+        for ( int i = 0; i < 2; i++ )
+        {
+            if ( const auto animatedItem = layoutItemAt( i ) )
+            {
+                startRenderAnimator( i, animatedItem->item(),
+                    QskRenderAnimator::Opacity, 1.0 - i, i );
+            }
+        }
+    }
 }
 
 void QskStackBoxAnimator3::advance( qreal value )
 {
+    if ( isRenderAnimated() )
+        return;
+
     QskLayoutItem* layoutItem1 = layoutItemAt( 0 );
     if ( layoutItem1 )
         layoutItem1->item()->setOpacity( 1.0 - value );
@@ -260,6 +466,8 @@ void QskStackBoxAnimator3::advance( qreal value )
 
 void QskStackBoxAnimator3::done()
 {
+    stopRenderAnimators();
+
     for ( int i = 0; i < 2; i++ )
     {
         if ( QskLayoutItem* layoutItem = layoutItemAt( i ) )
@@ -8,11 +8,14 @@
 
 #include "QskAnimator.h"
 #include "QskNamespace.h"
+#include "QskRenderAnimator.h"
 
 #include <qobject.h>
+#include <qpointer.h>
 
 class QskStackBox;
 class QskLayoutItem;
+class QQuickShaderEffectSource;
 
 class QSK_EXPORT QskStackBoxAnimator : public QObject, public QskAnimator
 {
@@ -28,14 +31,44 @@ class QSK_EXPORT QskStackBoxAnimator : public QObject, public QskAnimator
     int startIndex() const;
     int endIndex() const;
 
+    /*
+        Showing the end item - fully transparent - for one frame,
+        before starting the transition. Then the costs for polishing
+        and creating the scene graph nodes of an item, that has just
+        been created, are not part of the transition.
+     */
+    void startDeferred();
+    bool isPending() const;
+
+    // completes a pending or running transition
+    void finish();
+
   protected:
     QskStackBox* stackBox() const;
     QskLayoutItem* layoutItemAt( int index ) const;
     void resizeItemAt( int index );
 
+    /*
+        With the threaded render loop the items are animated on the
+        scene graph thread, so that the transition continues, when the
+        GUI thread is busy. advance() has nothing to do then.
+     */
+    void startRenderAnimator( int index, QQuickItem*,
+        QskRenderAnimator::Property, qreal from, qreal to );
+
+    void stopRenderAnimators();
+    bool isRenderAnimated() const;
+
   private:
+    void startPending();
+
     int m_startIndex;
     int m_endIndex;
+
+    QskRenderAnimator* m_renderAnimators[ 2 ];
+    bool m_isRenderAnimated;
+
+    QMetaObject::Connection m_pendingConnection;
 };
 
 class QSK_EXPORT QskStackBoxAnimator1 : public QskStackBoxAnimator
@@ -49,17 +82,31 @@ class QSK_EXPORT QskStackBoxAnimator1 : public QskStackBoxAnimator
     void setOrientation( Qt::Orientation );
     Qt::Orientation orientation() const;
 
+    /*
+        In snapshot mode the outgoing item is rendered once into
+        a texture, that is moved instead of the item. Updates of the
+        item are not visible until the transition has been completed.
+     */
+    void setSnapshotMode( bool );
+    bool isSnapshotMode() const;
+
   protected:
     void setup() override;
     void advance( qreal value ) override;
     void done() override;
 
   private:
+    QQuickItem* animatedItem( int index ) const;
+    qreal itemPosition( int index, qreal value ) const;
+
     qreal m_itemOffset[ 2 ];
 
+    QPointer< QQuickShaderEffectSource > m_snapshot;
+
     Qt::Orientation m_orientation : 2;
     Qsk::Direction m_direction : 4;
     bool m_hasClip : 1;
+    bool m_snapshotMode : 1;
 };
 
 class QSK_EXPORT QskStackBoxAnimator3 : public QskStackBoxAnimator
@@ -7,8 +7,10 @@
 #include "QskTextColors.h"
 #include "QskTextOptions.h"
 
+#include <qcache.h>
 #include <qfontmetrics.h>
 #include <qmath.h>
+#include <qmutex.h>
 #include <qsgnode.h>
 
 QSK_QT_PRIVATE_BEGIN
@@ -26,11 +28,149 @@ QSK_QT_PRIVATE_END
 
 #define GlyphFlag static_cast< QSGNode::Flag >( 0x800 )
 
+namespace
+{
+    class ElideKey
+    {
+      public:
+        inline bool operator==( const ElideKey& other ) const
+        {
+            return ( width == other.width ) && ( elideMode == other.elideMode )
+                && ( text == other.text ) && ( font == other.font );
+        }
+
+        QString text;
+        QFont font;
+        qreal width;
+        Qt::TextElideMode elideMode;
+    };
+
+    inline uint qHash( const ElideKey& key, uint seed = 0 )
+    {
+        uint hash = ::qHash( key.text, seed );
+        hash = ::qHash( key.font, hash );
+        hash = ::qHash( key.width, hash );
+        hash = ::qHash( static_cast< int >( key.elideMode ), hash );
+
+        return hash;
+    }
+
+    /*
+        Views with many elided cells are updating the same texts
+        for the same widths over and over. So we remember the
+        results to avoid shaping each text twice for every update.
+     */
+    class ElideCache
+    {
+      public:
+        ElideCache()
+            : m_cache( 2000 )
+        {
+        }
+
+        QString elidedText( const QString& text, const QFont& font,
+            Qt::TextElideMode elideMode, qreal width )
+        {
+            const ElideKey key { text, font, width, elideMode };
+
+            QMutexLocker locker( &m_mutex );
+
+            if ( const auto elided = m_cache.object( key ) )
+                return *elided;
+
+            locker.unlock();
+
+            const QFontMetricsF fm( font );
+            const auto elided = fm.elidedText(
+                text, elideMode, width, Qt::TextShowMnemonic );
+
+            locker.relock();
+            m_cache.insert( key, new QString( elided ) );
+
+            return elided;
+        }
+
+      private:
+        QMutex m_mutex;
+        QCache< ElideKey, QString > m_cache;
+    };
+
+    class SizeKey
+    {
+      public:
+        inline bool operator==( const SizeKey& other ) const
+        {
+            return ( flags == other.flags )
+                && ( text == other.text ) && ( font == other.font );
+        }
+
+        QString text;
+        QFont font;
+        int flags;
+    };
+
+    inline uint qHash( const SizeKey& key, uint seed = 0 )
+    {
+        uint hash = ::qHash( key.text, seed );
+        hash = ::qHash( key.font, hash );
+        hash = ::qHash( key.flags, hash );
+
+        return hash;
+    }
+
+    /*
+        The implicit sizes of labels are requested again for each
+        layout request. Remembering them also allows to measure the texts
+        of many labels in advance from worker threads.
+     */
+    class SizeCache
+    {
+      public:
+        SizeCache()
+            : m_cache( 5000 )
+        {
+        }
+
+        QSizeF textSize( const QString& text, const QFont& font, int flags )
+        {
+            const SizeKey key { text, font, flags };
+
+            QMutexLocker locker( &m_mutex );
+
+            if ( const auto size = m_cache.object( key ) )
+                return *size;
+
+            locker.unlock();
+
+            const QFontMetricsF fm( font );
+            const QRectF r( 0, 0, 10e6, 10e6 );
+
+            const auto size = fm.boundingRect( r, flags, text ).size();
+
+            locker.relock();
+            m_cache.insert( key, new QSizeF( size ) );
+
+            return size;
+        }
+
+      private:
+        QMutex m_mutex;
+        QCache< SizeKey, QSizeF > m_cache;
+    };
+}
+
+/*
+    text nodes might be updated from the render threads of
+    different windows
+ */
+Q_GLOBAL_STATIC( ElideCache, qskElideCache )
+Q_GLOBAL_STATIC( SizeCache, qskSizeCache )
+
 QSizeF QskPlainTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options )
 {
     // result differs from QQuickText::implicitSizeHint ???
-    return textRect( text, font, options, QSizeF( 10e6, 10e6 ) ).size();
+    return qskSizeCache->textSize( text, font, options.textFlags() );
 }
 
 QRectF QskPlainTextRenderer::textRect(
@@ -43,6 +183,15 @@ QRectF QskPlainTextRenderer::textRect(
     return fm.boundingRect( r, options.textFlags(), text );
 }
 
+QString QskPlainTextRenderer::elidedText( const QString& text,
+    const QFont& font, Qt::TextElideMode elideMode, qreal width )
+{
+    if ( elideMode == Qt::ElideNone || text.isEmpty() )
+        return text;
+
+    return qskElideCache->elidedText( text, font, elideMode, width );
+}
+
 static qreal qskLayoutText( QTextLayout* layout,
     qreal lineWidth, const QskTextOptions& options )
 {
@@ -69,15 +218,7 @@ static qreal qskLayoutText( QTextLayout* layout,
     }
     else
     {
-        const auto engine = layout->engine();
-
-        auto text = engine->elidedText(
-            elideMode, QFixed::fromReal( lineWidth ),
-            Qt::TextShowMnemonic, 0 );
-
-        // why do we need this padding ???
-        text = text.leftJustified( engine->text.length() );
-        engine->text = text;
+        // the text has already been elided, see QskPlainTextRenderer::updateNode
 
         auto line = layout->createLine();
 
@@ -195,6 +336,9 @@ void QskPlainTextRenderer::updateNode( const QString& text,
         tmp.replace( QLatin1Char('\n'), QChar::LineSeparator );
     }
 
+    const auto elideMode = options.effectiveElideMode();
+    if ( elideMode != Qt::ElideNone )
+        tmp = elidedText( tmp, font, elideMode, rect.width() );
 
     QTextLayout layout;
     layout.setFont( font );
@@ -29,6 +29,9 @@ namespace QskPlainTextRenderer
 
     QSK_EXPORT QRectF textRect( const QString&,
         const QFont&, const QskTextOptions&, const QSizeF& );
+
+    QSK_EXPORT QString elidedText( const QString&,
+        const QFont&, Qt::TextElideMode, qreal width );
 }
 
 #endif
@@ -4,6 +4,7 @@ TARGET   = $$qskLibraryTarget(qskinny)
 QT += quick quick-private
 
 contains(QSK_CONFIG, QskDll): DEFINES += QSK_MAKEDLL
+contains(QSK_CONFIG, QskLayoutProfiler): DEFINES += QSK_LAYOUT_PROFILER
 
 QSK_SUBDIRS = common graphic nodes controls layouts dialogs inputpanel
 INCLUDEPATH *= $${QSK_SUBDIRS}
@@ -120,8 +121,10 @@ HEADERS += \
     controls/QskGraphicLabelSkinlet.h \
     controls/QskHintAnimator.h \
     controls/QskInputGrabber.h \
+    controls/QskLayoutProfiler.h \
     controls/QskListView.h \
     controls/QskListViewSkinlet.h \
+    controls/QskModelListView.h \
     controls/QskObjectTree.h \
     controls/QskPageIndicator.h \
     controls/QskPageIndicatorSkinlet.h \
@@ -130,6 +133,7 @@ HEADERS += \
     controls/QskPopupSkinlet.h \
     controls/QskPushButton.h \
     controls/QskPushButtonSkinlet.h \
+    controls/QskRenderAnimator.h \
     controls/QskQuick.h \
     controls/QskRangeControl.h \
     controls/QskScrollArea.h \
@@ -184,8 +188,10 @@ SOURCES += \
     controls/QskGraphicLabelSkinlet.cpp \
     controls/QskHintAnimator.cpp \
     controls/QskInputGrabber.cpp \
+    controls/QskLayoutProfiler.cpp \
     controls/QskListView.cpp \
     controls/QskListViewSkinlet.cpp \
+    controls/QskModelListView.cpp \
     controls/QskObjectTree.cpp \
     controls/QskPageIndicator.cpp \
     controls/QskPageIndicatorSkinlet.cpp \
@@ -194,6 +200,7 @@ SOURCES += \
     controls/QskPopupSkinlet.cpp \
     controls/QskPushButton.cpp \
     controls/QskPushButtonSkinlet.cpp \
+    controls/QskRenderAnimator.cpp \
     controls/QskQuick.cpp \
     controls/QskRangeControl.cpp \
     controls/QskScrollArea.cpp \
@@ -232,10 +239,12 @@ SOURCES += \
     controls/QskWindow.cpp
 
 HEADERS += \
+    layouts/QskFlowBox.h \
     layouts/QskGridBox.h \
     layouts/QskIndexedLayoutBox.h \
     layouts/QskLayoutEngine.h \
     layouts/QskLayoutBox.h \
+    layouts/QskLayoutChain.h \
     layouts/QskLayoutConstraint.h \
     layouts/QskLayoutItem.h \
     layouts/QskLinearBox.h \
@@ -243,9 +252,11 @@ HEADERS += \
     layouts/QskStackBox.h
 
 SOURCES += \
+    layouts/QskFlowBox.cpp \
     layouts/QskGridBox.cpp \
     layouts/QskIndexedLayoutBox.cpp \
     layouts/QskLayoutBox.cpp \
+    layouts/QskLayoutChain.cpp \
     layouts/QskLayoutConstraint.cpp \
     layouts/QskLayoutEngine.cpp \
     layouts/QskLayoutItem.cpp \